@@ -137,6 +137,8 @@ bool ADS1118::getADCValueNoWait(uint8_t pin_drdy, uint16_t &value) {
 	dataLSB = pSpi->transfer(configRegister.byte.lsb);
 	digitalWrite(cs, HIGH);
 	pSpi->endTransaction();
+	startedConfig = NO_CONFIG;	//16-bit frames carry no config echo
+	frames++;
 
 	value = (dataMSB << 8) | (dataLSB);
     return true;
@@ -165,19 +167,14 @@ bool ADS1118::getMilliVoltsNoWait(uint8_t pin_drdy, double &volts) {
 
 
 /**
- * Getting a sample from the specified input
- * @param inputs Sets the input of the ADC: Diferential inputs: DIFF_0_1, DIFF_0_3, DIFF_1_3, DIFF_2_3. Single ended input: AIN_0, AIN_1, AIN_2, AIN_3
+ * Sending the config register in a 32-bit frame and checking the config echoed by the chip.
+ * The data of a frame belongs to the conversion started by the previous frame, so it is
+ * valid only if that frame applied the requested config and this frame is not corrupted.
+ * @param valid Set to true if the echo of this frame and the config of the conversion read match the config register
  * @return A word containing the ADC value
  */
-uint16_t ADS1118::getADCValue(uint8_t inputs) {
-    uint16_t value;
-    byte dataMSB, dataLSB, configMSB, configLSB, count=0;
-	if(lastSensorMode==ADC_MODE)  //Lucky you! We don't have to read twice the sensor
-		count=1;
-	else
-	configRegister.bits.sensorMode=ADC_MODE; //Sorry but we will have to read twice the sensor
-	configRegister.bits.mux=inputs;
-    do{
+uint16_t ADS1118::transferFrame(bool &valid) {
+    byte dataMSB, dataLSB, configMSB, configLSB;
 #if defined(ESP32)
 	pSpi->beginTransaction(SPISettings(SCLK, MSBFIRST, SPI_MODE1));
 #endif        
@@ -193,18 +190,47 @@ uint16_t ADS1118::getADCValue(uint8_t inputs) {
 	configMSB = pSpi->transfer(configRegister.byte.msb);
 	configLSB = pSpi->transfer(configRegister.byte.lsb);        
 #endif 
-
-	
         digitalWrite(cs, HIGH);
 #if defined(ESP32)        
 	pSpi->endTransaction();
 #endif         
-	for(int i=0;i<CONV_TIME[configRegister.bits.rate];i++) //Lets wait the conversion time
+    uint16_t written = configRegister.word & ECHO_MASK;
+    uint16_t echo = ((configMSB << 8) | configLSB) & ECHO_MASK;
+    valid = (echo==written) && (startedConfig==written);
+    frames++;
+    if (echo!=written) frameErrors++;
+    startedConfig = (echo==written) ? written : NO_CONFIG;  //Config of the conversion started by this frame
+    return (dataMSB << 8) | (dataLSB);
+}
+
+
+/**
+ * Getting a sample from the specified input. If the config echoed by the chip doesn't match,
+ * the read is repeated (up to the retries set by setMaxRetries()). See lastSampleValid()
+ * @param inputs Sets the input of the ADC: Diferential inputs: DIFF_0_1, DIFF_0_3, DIFF_1_3, DIFF_2_3. Single ended input: AIN_0, AIN_1, AIN_2, AIN_3
+ * @return A word containing the ADC value
+ */
+uint16_t ADS1118::getADCValue(uint8_t inputs) {
+    uint16_t value;
+    byte count=0, retries=0;
+    uint8_t waitMs=ADS1118Noise::conversionTimeMs(configRegister.bits.rate);
+    if(lastSensorMode==ADC_MODE)  //Lucky you! We don't have to read twice the sensor
+        count=1;
+    else
+        configRegister.bits.sensorMode=ADC_MODE; //Sorry but we will have to read twice the sensor
+    configRegister.bits.mux=inputs;
+    do{
+        value = transferFrame(sampleValid);
+        for(uint8_t i=0;i<waitMs;i++){ //Lets wait the conversion time
             delayMicroseconds(1000);
-            count++;
-	}while (count<=1);  //We make two readings because the second reading is the ADC conversion.	
-        DEBUG_GETADCVALUE(configRegister);  //Debug this method: print the config register in the Serial port
-	value = (dataMSB << 8) | (dataLSB);
+        }
+        count++;
+        if(count>1 && !sampleValid && retries<maxRetries){ //Bus glitch: read again
+            retries++;
+            count=(startedConfig==NO_CONFIG) ? 0 : 1;  //Two frames again unless the last one started the right conversion
+        }
+    }while (count<=1);  //We make two readings because the second reading is the ADC conversion.
+    DEBUG_GETADCVALUE(configRegister);  //Debug this method: print the config register in the Serial port
     return value;
 }
 
@@ -215,17 +241,7 @@ uint16_t ADS1118::getADCValue(uint8_t inputs) {
  * @return A double (32bits) containing the ADC value in millivolts
  */
 double ADS1118::getMilliVolts(uint8_t inputs) {
-    float volts;
-    float fsr = pgaFSR[configRegister.bits.pga];
-    uint16_t value;
-    value=getADCValue(inputs);
-    if(value>=0x8000){
-	value=((~value)+1); //Applying binary twos complement format
-	volts=((float)(value*fsr/32768)*-1);
-    } else {
-	volts=(float)(value*fsr/32768);
-    }
-    return volts*1000;
+    return toMilliVolts(getADCValue(inputs));
 }
 
 
@@ -234,10 +250,18 @@ double ADS1118::getMilliVolts(uint8_t inputs) {
  * @return A double (32bits) containing the ADC value in millivolts
  */
 double ADS1118::getMilliVolts() {
+    return toMilliVolts(getADCValue(configRegister.bits.mux));
+}
+
+
+/**
+ * Converting an ADC value to millivolts with the full scale range of the config register
+ * @param value An ADC value in binary twos complement format
+ * @return A double (32bits) containing the ADC value in millivolts
+ */
+double ADS1118::toMilliVolts(uint16_t value) {
     float volts;
     float fsr = pgaFSR[configRegister.bits.pga];
-    uint16_t value;
-    value=getADCValue(configRegister.bits.mux);
     if(value>=0x8000){
 	value=((~value)+1); //Applying binary twos complement format
 	volts=((float)(value*fsr/32768)*-1);
@@ -255,38 +279,25 @@ double ADS1118::getMilliVolts() {
  */
 double ADS1118::getTemperature() {
     uint16_t convRegister;
-    uint8_t dataMSB, dataLSB, configMSB, configLSB, count=0;
+    uint8_t count=0, retries=0;
+    uint8_t waitMs=ADS1118Noise::conversionTimeMs(configRegister.bits.rate);
     if(lastSensorMode==TEMP_MODE)
         count=1;  //Lucky you! We don't have to read twice the sensor
     else
-	configRegister.bits.sensorMode=TEMP_MODE; //Sorry but we will have to read twice the sensor
+        configRegister.bits.sensorMode=TEMP_MODE; //Sorry but we will have to read twice the sensor
     do{
-#if defined(ESP32)
-	pSpi->beginTransaction(SPISettings(SCLK, MSBFIRST, SPI_MODE1));
-#endif
-	digitalWrite(cs, LOW);
-        
-#if defined(__AVR__)	
-        dataMSB = SPI.transfer(configRegister.byte.msb);
-        dataLSB = SPI.transfer(configRegister.byte.lsb);
-        configMSB = SPI.transfer(configRegister.byte.msb);
-        configLSB = SPI.transfer(configRegister.byte.lsb);        
-#elif defined(ESP32)
-        dataMSB = pSpi->transfer(configRegister.byte.msb);
-	dataLSB = pSpi->transfer(configRegister.byte.lsb);
-	configMSB = pSpi->transfer(configRegister.byte.msb);
-	configLSB = pSpi->transfer(configRegister.byte.lsb);        
-#endif
-	digitalWrite(cs, HIGH);
-#if defined(ESP32)
-	pSpi->endTransaction();
-#endif
-	for(int i=0;i<CONV_TIME[configRegister.bits.rate];i++) //Lets wait the conversion time
+        convRegister = transferFrame(sampleValid);
+        for(uint8_t i=0;i<waitMs;i++){ //Lets wait the conversion time
             delayMicroseconds(1000);
+        }
         count++;
+        if(count>1 && !sampleValid && retries<maxRetries){ //Bus glitch: read again
+            retries++;
+            count=(startedConfig==NO_CONFIG) ? 0 : 1;  //Two frames again unless the last one started the right conversion
+        }
     }while (count<=1);  //We make two readings because the second reading is the temperature.
     DEBUG_GETTEMPERATURE(configRegister);  //Debug this method: print the config register in the Serial port
-    convRegister = ((dataMSB << 8) | (dataLSB))>>2;
+    convRegister = convRegister>>2;
     if((convRegister<<2) >= 0x8000){
         convRegister=((~convRegister)>>2)+1; //Converting to right-justified and applying binary twos complement format
         return (double)(convRegister*0.03125*-1);
@@ -318,6 +329,51 @@ void ADS1118::setInputSelected(uint8_t input){
     configRegister.bits.mux=input;
 }
 
+/**
+ * Setting the sampling rate and full scale range chosen by ADS1118Noise::plan().
+ * Average plan.oversampling readings of each input to get the planned noise.
+ * @param plan A feasible plan. Nothing is changed if the plan is not feasible
+ */
+void ADS1118::applyPlan(const ADS1118Plan &plan){
+    if (!plan.feasible) return;
+    configRegister.bits.rate=plan.rate;
+    configRegister.bits.pga=plan.fsr;
+}
+
+/**
+ * True if the config echoed by the chip confirmed the last sample of getADCValue(), getMilliVolts()
+ * or getTemperature() (the NoWait methods use 16-bit frames and are not checked)
+ * @return False if the sample could be corrupted or belong to another input
+ */
+bool ADS1118::lastSampleValid(){
+    return sampleValid;
+}
+
+/**
+ * Number of frames whose config echo didn't match the config register since the start
+ * @return The number of corrupted frames
+ */
+uint32_t ADS1118::getFrameErrors(){
+    return frameErrors;
+}
+
+/**
+ * Number of SPI frames sent to the chip since the start (32-bit frames and 16-bit NoWait frames)
+ * @return The number of frames
+ */
+uint32_t ADS1118::getFrames(){
+    return frames;
+}
+
+/**
+ * Setting how many times a read can be repeated to get a valid sample when the echo doesn't match.
+ * A retry takes two frames (one if the last frame already started the right conversion)
+ * @param retries Number of retries (0: no retries). Default: 2
+ */
+void ADS1118::setMaxRetries(uint8_t retries){
+    maxRetries=retries;
+}
+
 /**
  * Setting to continuous adquisition mode
  */
@@ -4,31 +4,8 @@
 #include "Arduino.h"
 #include <SPI.h>
 #include <stdint.h>
-/**
-* Union representing the "config register" in 3 ways: 
-* bits, word (16 bits) and nibbles (4 bits)
-* (See the datasheet [1] for more information)
-*/
-///Union configuration register
-union Config {
-	///Structure of the config register of the ADS1118. (See datasheet [1])
-	struct {					
-		uint8_t reserved:1;    	///< "Reserved" bit
-		uint8_t noOperation:2; 	///< "NOP" bits
-		uint8_t pullUp:1;	   	///< "PULL_UP_EN" bit	
-		uint8_t sensorMode:1;  	///< "TS_MODE" bit	
-		uint8_t rate:3;		   	///< "DR" bits
-		uint8_t operatingMode:1;///< "MODE" bit		
-		uint8_t pga:3;			///< "PGA" bits
-		uint8_t mux:3;			///< "MUX" bits
-		uint8_t singleStart:1;  ///< "SS" bit
-	} bits;
-	uint16_t word;				///< Representation in word (16-bits) format
-	struct {
-		uint8_t lsb;			///< Byte LSB
-		uint8_t msb;			///< Byte MSB
-	} byte;						///< Representation in bytes (8-bits) format
-};
+#include "ADS1118Config.h"
+#include "ADS1118Noise.h"
 
 
 /**
@@ -50,6 +27,7 @@ class ADS1118 {
 	bool getMilliVoltsNoWait(uint8_t pin_drdy, double &volts); ///< Getting the millivolts from the settled inputs
         double getMilliVolts(uint8_t inputs);					///< Getting the millivolts from the specified inputs
 	double getMilliVolts();				///< Getting the millivolts from the settled inputs
+	double toMilliVolts(uint16_t value);///< Converting an ADC value to millivolts with the full scale range set
         void decodeConfigRegister(union Config configRegister);	///< Decoding a configRegister structure and then print it out to the Serial port
 	void setSamplingRate(uint8_t samplingRate);				///< Setting the sampling rate specified in the config register
 	void setFullScaleRange(uint8_t fsr);///< Setting the full scale range in the config register
@@ -58,6 +36,11 @@ class ADS1118 {
 	void disablePullup();				///< Disabling the internal pull-up resistor of the DOUT pin
 	void enablePullup();				///< Enabling the internal pull-up resistor of the DOUT pin
 	void setInputSelected(uint8_t input);///< Setting the inputs to be adquired in the config register.
+	void applyPlan(const ADS1118Plan &plan);///< Setting the sampling rate and full scale range chosen by ADS1118Noise::plan()
+	bool lastSampleValid();				///< True if the config echoed by the chip confirmed the last sample
+	uint32_t getFrameErrors();			///< Number of frames whose config echo didn't match
+	uint32_t getFrames();				///< Number of SPI frames sent to the chip
+	void setMaxRetries(uint8_t retries);///< Setting the retries allowed to get a valid sample
 	//Input multiplexer configuration selection for bits "MUX"
 	//Differential inputs
         const uint8_t DIFF_0_1 	  = 0b000; 	///< Differential input: Vin=A0-A1
@@ -120,10 +103,17 @@ private:
 #if defined(ESP32)
 	SPIClass *pSpi;
 #endif  
+	uint16_t transferFrame(bool &valid);	///< Sending the config register in a 32-bit frame and checking its echo
 	uint8_t lastSensorMode=3;			///< Last sensor mode selected (ADC_MODE or TEMP_MODE or none)
+	const uint16_t ECHO_MASK = 0x7FF8;	///< Config bits compared with the echo (SS, NOP and Reserved don't read back as written)
+	const uint16_t NO_CONFIG = 0xFFFF;	///< No confirmed config (never matches a masked config)
+	uint16_t startedConfig = 0xFFFF;	///< Masked config of the conversion in progress, confirmed by its echo
+	bool sampleValid = false;			///< Validity of the last sample
+	uint8_t maxRetries = 2;				///< Retries allowed to get a valid sample
+	uint32_t frameErrors = 0;			///< Frames whose config echo didn't match
+	uint32_t frames = 0;				///< SPI frames sent to the chip
         uint8_t cs;                         ///< Chip select pin (choose one)		
 	const float pgaFSR[8] = {6.144, 4.096, 2.048, 1.024, 0.512, 0.256, 0.256, 0.256};
-	const uint8_t CONV_TIME[8]={125, 63, 32, 16, 8, 4, 3, 2}; 	///< Array containing the conversions time in ms
 
 /*
 							Table 1. Noise in μVRMS (μVPP) at VDD = 3.3 V   [1]
@@ -157,6 +147,9 @@ private:
 	
 	Note: This information is taken from http://www.ti.com
 	      Copyright © 2010–2015, Texas Instruments Incorporated
+
+	These tables are available as data through ADS1118Noise (see ADS1118Noise::plan()). The conversion
+	waits are ADS1118Noise::conversionTimeMs()
 */		
 
 };
@@ -0,0 +1,32 @@
+#ifndef ADS1118Config_h
+#define ADS1118Config_h
+
+#include <stdint.h>
+
+/**
+* Union representing the "config register" in 3 ways: 
+* bits, word (16 bits) and nibbles (4 bits)
+* (See the datasheet [1] for more information)
+*/
+///Union configuration register
+union Config {
+	///Structure of the config register of the ADS1118. (See datasheet [1])
+	struct {					
+		uint8_t reserved:1;    	///< "Reserved" bit
+		uint8_t noOperation:2; 	///< "NOP" bits
+		uint8_t pullUp:1;	   	///< "PULL_UP_EN" bit	
+		uint8_t sensorMode:1;  	///< "TS_MODE" bit	
+		uint8_t rate:3;		   	///< "DR" bits
+		uint8_t operatingMode:1;///< "MODE" bit		
+		uint8_t pga:3;			///< "PGA" bits
+		uint8_t mux:3;			///< "MUX" bits
+		uint8_t singleStart:1;  ///< "SS" bit
+	} bits;
+	uint16_t word;				///< Representation in word (16-bits) format
+	struct {
+		uint8_t lsb;			///< Byte LSB
+		uint8_t msb;			///< Byte MSB
+	} byte;						///< Representation in bytes (8-bits) format
+};
+
+#endif
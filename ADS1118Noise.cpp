@@ -0,0 +1,226 @@
+/**
+*  Noise tables and configuration planner for the Arduino Library for Texas Instruments ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+
+/**
+ * The MIT License
+ *
+ * Copyright 2018 Alvaro Salazar <alvaro@denkitronik.com>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ADS1118Noise.h"
+#include <math.h>
+
+//The tables are only read through the functions below: on AVR they stay in flash
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+    #define ADS1118_PROGMEM PROGMEM
+    #define READ_WORD(address) pgm_read_word(address)
+    #define READ_BYTE(address) pgm_read_byte(address)
+#else
+    #define ADS1118_PROGMEM
+    #define READ_WORD(address) (*(address))
+    #define READ_BYTE(address) (*(address))
+#endif
+
+const uint16_t ADS1118Noise::SPS[8] ADS1118_PROGMEM = {8, 16, 32, 64, 128, 250, 475, 860};
+const uint16_t ADS1118Noise::FSR_MV[FSR_COUNT] ADS1118_PROGMEM = {6144, 4096, 2048, 1024, 512, 256};
+const uint8_t ADS1118Noise::FSR_CODE[FSR_COUNT] ADS1118_PROGMEM = {0b000, 0b001, 0b010, 0b011, 0b100, 0b111};
+const uint8_t ADS1118Noise::CONV_TIME_MS[8] ADS1118_PROGMEM = {125, 63, 32, 16, 8, 4, 3, 2};
+
+//Table 1. Noise in μVRMS x100 at VDD = 3.3 V (one LSB: the same at every data rate)
+//                                                        ±6.144  ±4.096  ±2.048  ±1.024  ±0.512  ±0.256
+const uint16_t ADS1118Noise::NOISE_RMS[FSR_COUNT] ADS1118_PROGMEM = {18750,  12500,  6250,   3125,   1562,   781};
+
+//Table 1. Noise in μVPP x100 at VDD = 3.3 V
+const uint16_t ADS1118Noise::NOISE_PP[8][FSR_COUNT] ADS1118_PROGMEM = {
+//   ±6.144  ±4.096  ±2.048  ±1.024  ±0.512  ±0.256
+    {18750,  12500,  6250,   3125,   1562,   781},	// 8 SPS
+    {18750,  12500,  6250,   3125,   1562,   781},	// 16 SPS
+    {18750,  12500,  6250,   3125,   1562,   781},	// 32 SPS
+    {18750,  12500,  6250,   3125,   1562,   781},	// 64 SPS
+    {18750,  12500,  6250,   3125,   1562,   1235},	// 128 SPS
+    {25209,  14828,  8403,   3954,   1606,   1853},	// 250 SPS
+    {26692,  22738,  7908,   5684,   3213,   2595},	// 475 SPS
+    {43006,  26693,  11863,  6426,   4078,   3583}	// 860 SPS
+};
+
+//Table 2. Noise-free bits from peak-to-peak noise x100 at VDD = 3.3 V
+const uint16_t ADS1118Noise::NOISE_FREE_BITS[8][FSR_COUNT] ADS1118_PROGMEM = {
+//   ±6.144  ±4.096  ±2.048  ±1.024  ±0.512  ±0.256
+    {1600,   1600,   1600,   1600,   1600,   1600},	// 8 SPS
+    {1600,   1600,   1600,   1600,   1600,   1600},	// 16 SPS
+    {1600,   1600,   1600,   1600,   1600,   1600},	// 32 SPS
+    {1600,   1600,   1600,   1600,   1600,   1600},	// 64 SPS
+    {1600,   1600,   1600,   1600,   1600,   1533},	// 128 SPS
+    {1557,   1575,   1557,   1566,   1596,   1475},	// 250 SPS
+    {1549,   1513,   1566,   1513,   1495,   1426},	// 475 SPS
+    {1480,   1490,   1507,   1495,   1461,   1380}	// 860 SPS
+};
+
+/*
+	[1] Texas Instruments, "ADS1118 Ultrasmall, Low-Power, SPI™-Compatible, 16-Bit Analog-to-Digital
+	Converter with Internal Reference and Temperature Sensor", ADS1118 datasheet, SBAS457E [OCTOBER 2010–REVISED OCTOBER 2015].
+
+	Note: This information is taken from http://www.ti.com
+	      Copyright © 2010–2015, Texas Instruments Incorporated
+*/
+
+/**
+ * Noise in μVRMS (Table 1 of the datasheet)
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @param fsr The full scale range: FSR_6144 ... FSR_0256
+ * @return The RMS noise in μV
+ */
+float ADS1118Noise::noiseRms(uint8_t rate, uint8_t fsr) {
+    (void)rate;
+    return READ_WORD(&NOISE_RMS[fsrIndex(fsr)])/100.0;
+}
+
+/**
+ * Noise in μVPP (Table 1 of the datasheet)
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @param fsr The full scale range: FSR_6144 ... FSR_0256
+ * @return The peak-to-peak noise in μV
+ */
+float ADS1118Noise::noisePeakToPeak(uint8_t rate, uint8_t fsr) {
+    return READ_WORD(&NOISE_PP[rate & 0b111][fsrIndex(fsr)])/100.0;
+}
+
+/**
+ * ENOB from RMS noise (Table 2 of the datasheet)
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @param fsr The full scale range: FSR_6144 ... FSR_0256
+ * @return The effective number of bits
+ */
+float ADS1118Noise::enob(uint8_t rate, uint8_t fsr) {
+    (void)rate;
+    (void)fsr;
+    return ENOB_RMS/100.0;
+}
+
+/**
+ * Noise-free bits from peak-to-peak noise (Table 2 of the datasheet)
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @param fsr The full scale range: FSR_6144 ... FSR_0256
+ * @return The noise-free bits
+ */
+float ADS1118Noise::noiseFreeBits(uint8_t rate, uint8_t fsr) {
+    return READ_WORD(&NOISE_FREE_BITS[rate & 0b111][fsrIndex(fsr)])/100.0;
+}
+
+/**
+ * Samples per second of a DR code
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @return The data rate in samples per second
+ */
+uint16_t ADS1118Noise::samplesPerSecond(uint8_t rate) {
+    return READ_WORD(&SPS[rate & 0b111]);
+}
+
+/**
+ * Full scale range of a PGA code
+ * @param fsr The full scale range: FSR_6144 ... FSR_0256
+ * @return The full scale range in mV (Example: 2048 for ±2.048 V)
+ */
+uint16_t ADS1118Noise::fullScaleMilliVolts(uint8_t fsr) {
+    return READ_WORD(&FSR_MV[fsrIndex(fsr)]);
+}
+
+/**
+ * PGA code of an FSR index, the inverse of fsrIndex()
+ * @param index The FSR index: 0 (±6.144 V) to FSR_COUNT-1 (±0.256 V)
+ * @return The full scale range: FSR_6144 ... FSR_0256
+ */
+uint8_t ADS1118Noise::fsrCode(uint8_t index) {
+    return READ_BYTE(&FSR_CODE[(index<FSR_COUNT) ? index : FSR_COUNT-1]);
+}
+
+/**
+ * Wait of the ADS1118 class after every frame: the conversion time rounded up to whole ms
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @return The wait in ms
+ */
+uint8_t ADS1118Noise::conversionTimeMs(uint8_t rate) {
+    return READ_BYTE(&CONV_TIME_MS[rate & 0b111]);
+}
+
+/**
+ * Time of one getADCValue() call of the ADS1118 class: two frames, each one followed by
+ * the conversion wait (the CPU time of the call is not included)
+ * @param rate The sampling rate: RATE_8SPS ... RATE_860SPS
+ * @return The time in ms
+ */
+float ADS1118Noise::conversionCostMs(uint8_t rate) {
+    return FRAMES_PER_CONVERSION*(conversionTimeMs(rate) + FRAME_US/1000.0);
+}
+
+/**
+ * Choosing the fastest configuration meeting a noise target. Every FSR covering the input
+ * range is tried (the smallest one is not always the least noisy: at 250 SPS ±0.512 V is
+ * quieter than ±0.256 V) with every data rate. For each one the conversions needed to average
+ * the peak-to-peak noise down to the target are computed (noise/sqrt(N), never below one LSB),
+ * and the time of a reading is the cost of that many getADCValue() calls of the ADS1118 class,
+ * which makes two frames per conversion and waits the conversion time rounded up to whole ms
+ * after each one. The configuration giving more readings per second wins; on a tie the lower
+ * noise, then the smaller FSR and the slower data rate are kept.
+ * @param resolutionMicroVolts Maximum peak-to-peak noise allowed in μV
+ * @param rangeMilliVolts Maximum absolute input voltage in mV
+ * @param channels Number of channels read in turn
+ * @param latencyMs Maximum time to get one averaged reading of every channel in ms. 0: no limit
+ * @return The plan. plan.feasible is false if no configuration meets the requirements
+ */
+ADS1118Plan ADS1118Noise::plan(float resolutionMicroVolts, float rangeMilliVolts, uint8_t channels, float latencyMs) {
+    ADS1118Plan best = {false, 0, 0, 0, 0, 0, 0};
+    if (channels==0 || resolutionMicroVolts<=0) return best;
+    for (int8_t fsr=FSR_COUNT-1; fsr>=0; fsr--) {
+        uint16_t range = READ_WORD(&FSR_MV[fsr]);
+        if (range<rangeMilliVolts) continue;
+        float lsb = range*1000.0/32768;  //μV
+        if (resolutionMicroVolts<lsb) continue;  //Averaging can't resolve less than one LSB
+        for (uint8_t rate=0; rate<8; rate++) {
+            float noise = READ_WORD(&NOISE_PP[rate][fsr])/100.0;
+            float ratio = noise/resolutionMicroVolts;
+            uint32_t oversampling = (ratio>1) ? (uint32_t)ceil(ratio*ratio) : 1;
+            if (oversampling>MAX_OVERSAMPLING) continue;
+            float latency = channels*oversampling*conversionCostMs(rate);
+            if (latencyMs>0 && latency>latencyMs) continue;
+            float readings = 1000.0/latency;
+            float averaged = noise/sqrt(oversampling);
+            if (averaged<lsb) averaged = lsb;
+            if (best.feasible && (readings<best.readingsPerSecond
+                    || (readings==best.readingsPerSecond && averaged>=best.noiseMicroVolts))) continue;
+            best.feasible = true;
+            best.rate = rate;
+            best.fsr = fsrCode(fsr);
+            best.oversampling = oversampling;
+            best.noiseMicroVolts = averaged;
+            best.readingsPerSecond = readings;
+            best.latencyMs = latency;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,64 @@
+#ifndef ADS1118Noise_h
+#define ADS1118Noise_h
+
+#include <stdint.h>
+
+/**
+ * Configuration chosen by ADS1118Noise::plan()
+ */
+struct ADS1118Plan {
+    bool     feasible;			///< False if no configuration meets the requirements (the other fields are not valid)
+    uint8_t  rate;				///< Sampling rate: RATE_8SPS ... RATE_860SPS
+    uint8_t  fsr;				///< Full scale range: FSR_6144 ... FSR_0256
+    uint16_t oversampling;		///< Number of conversions to be averaged per reading
+    float    noiseMicroVolts;	///< Expected peak-to-peak noise of the averaged reading in μV
+    float    readingsPerSecond;	///< Averaged readings per second of each channel with the ADS1118 class
+    float    latencyMs;			///< Time to get one averaged reading of every channel with the ADS1118 class in ms
+};
+
+
+/**
+ * Noise and ENOB of the ADS1118 (Tables 1 and 2 of the datasheet [1], VDD = 3.3 V) and a
+ * planner choosing the fastest configuration that meets a noise target.
+ * The tables are in ADS1118Noise.cpp, in flash (PROGMEM) on AVR, and are read with the
+ * functions below. They are indexed by [DR bits][FSR index]. The FSR index is the PGA code,
+ * except FSR_0256 (0b101, 0b110 and 0b111) which is index 5: use fsrIndex().
+ * @author Alvaro Salazar <alvaro@denkitronik.com>
+ */
+class ADS1118Noise {
+    public:
+        static float noiseRms(uint8_t rate, uint8_t fsr);		///< Noise in μVRMS
+        static float noisePeakToPeak(uint8_t rate, uint8_t fsr);///< Noise in μVPP
+        static float enob(uint8_t rate, uint8_t fsr);			///< ENOB from RMS noise
+        static float noiseFreeBits(uint8_t rate, uint8_t fsr);	///< Noise-free bits from peak-to-peak noise
+        static uint16_t samplesPerSecond(uint8_t rate);			///< Samples per second of a DR code
+        static uint16_t fullScaleMilliVolts(uint8_t fsr);		///< Full scale range of a PGA code in mV
+        static uint8_t fsrCode(uint8_t index);					///< PGA code of an FSR index (0 to FSR_COUNT-1)
+        static uint8_t conversionTimeMs(uint8_t rate);			///< Wait of the ADS1118 class after every frame in ms
+        static float conversionCostMs(uint8_t rate);			///< Time of one getADCValue() call of the ADS1118 class in ms
+        static ADS1118Plan plan(float resolutionMicroVolts, float rangeMilliVolts, uint8_t channels, float latencyMs=0);	///< Choosing the fastest configuration meeting a noise target
+
+        /**
+         * Column of the tables for a PGA code
+         * @param fsr The full scale range: FSR_6144, FSR_4096, FSR_2048, FSR_1024, FSR_0512, FSR_0256
+         * @return The FSR index (0 to 5)
+         */
+        static constexpr uint8_t fsrIndex(uint8_t fsr) { return (fsr>5) ? 5 : fsr; }
+
+        static const uint8_t FSR_COUNT = 6;				///< Number of FSR indexes (columns of the tables)
+        static const uint16_t MAX_OVERSAMPLING = 1024;	///< Maximum number of conversions averaged by a plan
+
+    private:
+        static const uint16_t SPS[8];				///< Samples per second of each DR code
+        static const uint16_t FSR_MV[FSR_COUNT];	///< Full scale range in mV of each FSR index
+        static const uint8_t FSR_CODE[FSR_COUNT];	///< PGA code of each FSR index
+        static const uint8_t CONV_TIME_MS[8];		///< Wait after every frame in ms (data rate period rounded up)
+        static const uint16_t NOISE_RMS[FSR_COUNT];	///< Table 1. Noise in μVRMS x100 (the same at every data rate)
+        static const uint16_t NOISE_PP[8][FSR_COUNT];		///< Table 1. Noise in μVPP x100
+        static const uint16_t NOISE_FREE_BITS[8][FSR_COUNT];///< Table 2. Noise-free bits x100
+        static const uint16_t ENOB_RMS = 1600;		///< Table 2. ENOB from RMS noise x100 (16 bits at every data rate and FSR)
+        static const uint16_t FRAME_US = 16;		///< 32-bit frame at the SCLK of the ADS1118 class (2 MHz)
+        static const uint8_t FRAMES_PER_CONVERSION = 2;	///< Frames sent by getADCValue(): configuration, then data
+};
+
+#endif
@@ -0,0 +1,171 @@
+/**
+*  Latest value table for the Arduino Library for Texas Instruments ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+
+/**
+ * The MIT License
+ *
+ * Copyright 2018 Alvaro Salazar <alvaro@denkitronik.com>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ADS1118Snapshot.h"
+
+#if !defined(__AVR__)
+
+#include <string.h>
+
+#if defined(__linux__) && !defined(ARDUINO)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * Constructor of the class: the table lives in this object (shared between threads)
+ */
+ADS1118Snapshot::ADS1118Snapshot() {
+    memset(&localTable, 0, sizeof(localTable));
+    localTable.magic = MAGIC;
+    localTable.size = sizeof(Table);
+    table = &localTable;
+    readOnly = false;
+}
+
+/**
+ * Destructor of the class: unmapping the shared table
+ */
+ADS1118Snapshot::~ADS1118Snapshot() {
+#if defined(__linux__) && !defined(ARDUINO)
+    closeShared();
+#endif
+}
+
+#if defined(__linux__) && !defined(ARDUINO)
+/**
+ * Using a table in POSIX shared memory, so other processes can read it
+ * @param name Name of the shared memory object. Example: "/ads1118"
+ * @param create True in the publisher: the table is created (or reset) and initialized.
+ * False in the readers: the table is mapped read-only and publish() does nothing
+ * @return False if the table couldn't be mapped or it is not initialized yet
+ */
+bool ADS1118Snapshot::openShared(const char *name, bool create) {
+    closeShared();
+    int fd = shm_open(name, create ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd<0) return false;
+    if (create && ftruncate(fd, sizeof(Table))<0) {
+        close(fd);
+        return false;
+    }
+    struct stat st;
+    if (!create && (fstat(fd, &st)<0 || st.st_size<(off_t)sizeof(Table))) {   //Not sized by the publisher yet: mapping it would fault
+        close(fd);
+        return false;
+    }
+    void *memory = mmap(0, sizeof(Table), create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory==MAP_FAILED) return false;
+    Table *shared = (Table *)memory;
+    if (create) {
+        memset(shared, 0, sizeof(Table));
+        shared->size = sizeof(Table);
+        __atomic_store_n(&shared->magic, MAGIC, __ATOMIC_RELEASE);
+    } else if (__atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE)!=MAGIC || shared->size!=sizeof(Table)) {
+        munmap(memory, sizeof(Table));
+        return false;
+    }
+    table = shared;
+    readOnly = !create;
+    return true;
+}
+
+/**
+ * Going back to the table of this object
+ */
+void ADS1118Snapshot::closeShared() {
+    if (table!=&localTable) munmap(table, sizeof(Table));
+    table = &localTable;
+    readOnly = false;
+}
+
+/**
+ * Removing a shared table. Processes that have it mapped can keep using it
+ * @param name Name of the shared memory object
+ * @return False if the table couldn't be removed
+ */
+bool ADS1118Snapshot::removeShared(const char *name) {
+    return shm_unlink(name)==0;
+}
+#endif
+
+/**
+ * Writing the latest reading of a channel. Only one thread or process can publish
+ * (nothing is written on a table opened by a reader)
+ * @param channel MUX code of the input (DIFF_0_1 ... AIN_3) or TEMPERATURE
+ * @param code ADC value returned by getADCValue()
+ * @param value Millivolts (or degrees celsius for TEMPERATURE)
+ * @param timestamp Time of the reading. Example: millis()
+ */
+void ADS1118Snapshot::publish(uint8_t channel, uint16_t code, float value, uint32_t timestamp) {
+    if (channel>=CHANNELS || readOnly) return;
+    Entry &entry = table->entries[channel];
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t lock = __atomic_load_n(&entry.lock, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry.lock, lock+1, __ATOMIC_RELAXED);   //Odd: readers will retry
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&entry.sequence, __atomic_load_n(&entry.sequence, __ATOMIC_RELAXED)+1, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry.timestamp, timestamp, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry.value, bits, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry.code, (uint32_t)code, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry.lock, lock+2, __ATOMIC_RELEASE);   //Even again: the entry is consistent
+}
+
+/**
+ * Getting a consistent copy of the latest reading of a channel
+ * @param channel MUX code of the input (DIFF_0_1 ... AIN_3) or TEMPERATURE
+ * @param reading Reference of the reading to be filled
+ * @return False if nothing has been published for this channel
+ */
+bool ADS1118Snapshot::read(uint8_t channel, ADS1118Reading &reading) {
+    if (channel>=CHANNELS) return false;
+    Entry &entry = table->entries[channel];
+    uint32_t before, after, bits, code;
+    do {
+        before = __atomic_load_n(&entry.lock, __ATOMIC_ACQUIRE);
+        reading.sequence = __atomic_load_n(&entry.sequence, __ATOMIC_RELAXED);
+        reading.timestamp = __atomic_load_n(&entry.timestamp, __ATOMIC_RELAXED);
+        bits = __atomic_load_n(&entry.value, __ATOMIC_RELAXED);
+        code = __atomic_load_n(&entry.code, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&entry.lock, __ATOMIC_RELAXED);
+    } while ((before & 1) || before!=after);   //Retrying while the publisher is writing this entry
+    memcpy(&reading.value, &bits, sizeof(bits));
+    reading.code = (uint16_t)code;
+    return reading.sequence>0;
+}
+
+#endif
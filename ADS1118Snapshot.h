@@ -0,0 +1,68 @@
+#ifndef ADS1118Snapshot_h
+#define ADS1118Snapshot_h
+
+#if !defined(__AVR__)
+
+#include <stdint.h>
+
+/**
+ * Latest reading of one channel, as returned by ADS1118Snapshot::read()
+ */
+struct ADS1118Reading {
+    uint32_t sequence;	///< Number of readings published for this channel (0: never published)
+    uint32_t timestamp;	///< Time of the reading given by the publisher (Example: millis())
+    float    value;		///< Millivolts, or degrees celsius for the TEMPERATURE channel
+    uint16_t code;		///< ADC value (binary twos complement format)
+};
+
+
+/**
+ * Table holding the latest reading of every input (MUX code 0 to 7) and of the
+ * internal temperature sensor, shared between threads or, on Linux, between
+ * processes through POSIX shared memory.
+ * Every entry is protected by its own seqlock: there must be only one publisher,
+ * which never waits, and any number of readers, which never lock nor touch the
+ * SPI bus; a reader only retries while the entry it reads is being written.
+ * @author Alvaro Salazar <alvaro@denkitronik.com>
+ */
+class ADS1118Snapshot {
+    public:
+        ADS1118Snapshot();					///< Constructor: the table lives in this object
+        ~ADS1118Snapshot();					///< Destructor: unmapping the shared table
+#if defined(__linux__) && !defined(ARDUINO)
+        bool openShared(const char *name, bool create);	///< Using a table in POSIX shared memory
+        void closeShared();					///< Going back to the table of this object
+        static bool removeShared(const char *name);	///< Removing a shared table (shm_unlink)
+#endif
+        void publish(uint8_t channel, uint16_t code, float value, uint32_t timestamp);	///< Writing the latest reading of a channel
+        bool read(uint8_t channel, ADS1118Reading &reading);	///< Getting a consistent copy of the latest reading of a channel
+
+        static const uint8_t TEMPERATURE = 8;	///< Channel of the internal temperature sensor (0 to 7 are the MUX codes)
+        static const uint8_t CHANNELS = 9;		///< Number of channels in the table
+
+    private:
+        ADS1118Snapshot(const ADS1118Snapshot &) = delete;				///< Not copyable: "table" points to a mapping or to localTable
+        ADS1118Snapshot &operator=(const ADS1118Snapshot &) = delete;	///< Not copyable
+        ///Entry of the table. "lock" is odd while the entry is being written
+        struct Entry {
+            uint32_t lock;		///< Seqlock counter
+            uint32_t sequence;	///< Number of readings published
+            uint32_t timestamp;	///< Time of the reading
+            uint32_t value;		///< Bits of the float value
+            uint32_t code;		///< ADC value
+        };
+        ///Layout of the table, also used in shared memory
+        struct Table {
+            uint32_t magic;		///< MAGIC once the table is initialized
+            uint32_t size;		///< sizeof(Table), to detect incompatible layouts
+            Entry entries[CHANNELS];
+        };
+        static const uint32_t MAGIC = 0x41313131;
+        Table localTable;		///< Table used when no shared memory is open
+        Table *table;			///< Table in use
+        bool readOnly;			///< True if the table in use was opened by a reader (mapped read-only)
+};
+
+#endif
+
+#endif
@@ -0,0 +1,263 @@
+/**
+*  Linux spidev backend for the Arduino Library for Texas Instruments ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+
+/**
+ * The MIT License
+ *
+ * Copyright 2018 Alvaro Salazar <alvaro@denkitronik.com>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ADS1118Spidev.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+const uint32_t ADS1118Spidev::CONV_TIME_US[8]={137500, 68750, 34375, 17188, 8594, 4400, 2316, 1280};
+
+/**
+ * Constructor of the class
+ * @param device Path of the spidev device. Example: "/dev/spidev0.0"
+ * @param ioctlFunction Function used instead of ioctl() (to simulate the device). 0 uses ioctl()
+ */
+ADS1118Spidev::ADS1118Spidev(const char *device, IoctlFunction ioctlFunction) {
+    this->device = device;
+    this->ioctlFunction = ioctlFunction;
+    fd = -1;
+    ownsFd = false;
+    syscalls = 0;
+    frameErrors = 0;
+    maxRetries = 2;
+    configRegister.word = 0;
+    configRegister.bits.reserved = 1;
+    configRegister.bits.noOperation = 0b01;
+    configRegister.bits.pullUp = 1;
+    configRegister.bits.rate = RATE_8SPS;
+    configRegister.bits.operatingMode = 1;     //Single shot: every frame starts one conversion
+    configRegister.bits.pga = FSR_0256;
+    configRegister.bits.mux = DIFF_0_1;
+    configRegister.bits.singleStart = 1;
+}
+
+/**
+ * Destructor of the class: closing the device if it was opened by begin()
+ */
+ADS1118Spidev::~ADS1118Spidev() {
+    end();
+}
+
+/**
+ * Opening the spidev device and setting the SPI mode, word size and SCLK
+ * @return False if the device couldn't be opened or configured
+ */
+bool ADS1118Spidev::begin() {
+    int descriptor = open(device, O_RDWR);
+    if (descriptor<0) return false;
+    if (!begin(descriptor)) {
+        close(descriptor);
+        return false;
+    }
+    ownsFd = true;
+    return true;
+}
+
+/**
+ * Using an already opened spidev file descriptor and setting the SPI mode, word size and SCLK
+ * @param fd The spidev file descriptor
+ * @return False if the SPI port couldn't be configured
+ */
+bool ADS1118Spidev::begin(int fd) {
+    uint8_t mode = SPI_MODE_1;
+    uint8_t bits = 8;
+    uint32_t speed = SCLK;
+    end();
+    this->fd = fd;
+    syscalls = 0;
+    if (doIoctl(SPI_IOC_WR_MODE, &mode)<0 || doIoctl(SPI_IOC_WR_BITS_PER_WORD, &bits)<0
+            || doIoctl(SPI_IOC_WR_MAX_SPEED_HZ, &speed)<0) {
+        this->fd = -1;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Closing the device (only if it was opened by begin())
+ */
+void ADS1118Spidev::end() {
+    if (ownsFd && fd>=0) close(fd);
+    fd = -1;
+    ownsFd = false;
+}
+
+/**
+ * Getting one sample of each input with a single ioctl() call. If a config echo doesn't
+ * match, the whole scan is repeated (up to the retries set by setMaxRetries())
+ * @param inputs Inputs to be adquired, in order: DIFF_0_1, DIFF_0_3, DIFF_1_3, DIFF_2_3, AIN_0, AIN_1, AIN_2, AIN_3
+ * @param count Number of inputs (1 to MAX_INPUTS)
+ * @param values Array of count words receiving the ADC values
+ * @param valid Array of count flags, true if the echoes confirmed the value (0 if not needed)
+ * @return False if the scan couldn't be made
+ */
+bool ADS1118Spidev::scan(const uint8_t *inputs, uint8_t count, uint16_t *values, bool *valid) {
+    bool flags[MAX_INPUTS];
+    if (fd<0 || count==0 || count>MAX_INPUTS) return false;
+    if (!valid) valid = flags;
+    for (uint8_t retries=0; ; retries++) {
+        if (!transferScan(inputs, count, values, valid)) return false;
+        bool allValid = true;
+        for (uint8_t i=0; i<count; i++) allValid = allValid && valid[i];
+        if (allValid || retries>=maxRetries) return true;
+    }
+}
+
+/**
+ * Making one scan and checking the config echoed in every frame. The value read in frame i+1
+ * is valid if frame i applied the config of inputs[i] and frame i+1 is not corrupted
+ * @param inputs Inputs to be adquired
+ * @param count Number of inputs (1 to MAX_INPUTS)
+ * @param values Array of count words receiving the ADC values
+ * @param valid Array of count flags receiving the validity of each value
+ * @return False if the ioctl() call failed
+ */
+bool ADS1118Spidev::transferScan(const uint8_t *inputs, uint8_t count, uint16_t *values, bool *valid) {
+    union Config frameConfig = configRegister;
+    uint16_t index = 0;
+    frameConfig.bits.sensorMode = 0;
+    frameConfig.bits.singleStart = 1;
+    frameConfig.bits.noOperation = 0b01;
+    for (uint8_t i=0; i<=count; i++) {
+        if (i<count) {
+            frameConfig.bits.mux = inputs[i];
+        } else {
+            frameConfig.bits.noOperation = 0b00;   //Last frame only reads: the config is not updated
+        }
+        txFrames[i][0] = frameConfig.byte.msb;
+        txFrames[i][1] = frameConfig.byte.lsb;
+        txFrames[i][2] = frameConfig.byte.msb;
+        txFrames[i][3] = frameConfig.byte.lsb;
+        index = addTransfer(index, txFrames[i], rxFrames[i], (i<count) ? CONV_TIME_US[configRegister.bits.rate] : 0);
+    }
+    transfers[index-1].cs_change = 0;   //cs_change in the last transfer would keep CS selected
+    if (doIoctl(SPI_IOC_MESSAGE(index), transfers)<0) return false;
+    bool previousOk = false;
+    for (uint8_t i=0; i<=count; i++) {
+        uint16_t written = ((txFrames[i][0] << 8) | txFrames[i][1]) & ECHO_MASK;
+        uint16_t echo = ((rxFrames[i][2] << 8) | rxFrames[i][3]) & ECHO_MASK;
+        bool frameOk = (echo==written);
+        if (!frameOk) frameErrors++;
+        if (i>0) {     //Frame i carries the conversion started by frame i-1
+            values[i-1] = (rxFrames[i][0] << 8) | rxFrames[i][1];
+            valid[i-1] = previousOk && frameOk;
+        }
+        previousOk = frameOk;
+    }
+    return true;
+}
+
+/**
+ * Adding a 32-bit frame followed by the conversion wait. Waits longer than 65535μs
+ * (delay_usecs is 16 bits) are completed with zero length transfers.
+ * @param index Position of the frame in the transfers array
+ * @param tx Frame to be written
+ * @param rx Buffer receiving the frame read
+ * @param waitUs Time to wait after the frame, in μs
+ * @return The position of the next transfer
+ */
+uint16_t ADS1118Spidev::addTransfer(uint16_t index, uint8_t *tx, uint8_t *rx, uint32_t waitUs) {
+    memset(&transfers[index], 0, sizeof(transfers[index]));
+    transfers[index].tx_buf = (uintptr_t)tx;
+    transfers[index].rx_buf = (uintptr_t)rx;
+    transfers[index].len = 4;
+    while (true) {
+        uint32_t chunk = (waitUs>0xFFFF) ? 0xFFFF : waitUs;
+        transfers[index].delay_usecs = chunk;
+        waitUs -= chunk;
+        if (waitUs==0) break;
+        index++;
+        memset(&transfers[index], 0, sizeof(transfers[index]));
+    }
+    transfers[index].cs_change = 1;     //CS goes high after the wait, the next frame starts with CS low
+    return index+1;
+}
+
+/**
+ * Calling ioctl() (or its replacement) and counting the call
+ * @param request The ioctl request
+ * @param arg The ioctl argument
+ * @return The value returned by ioctl()
+ */
+int ADS1118Spidev::doIoctl(unsigned long request, void *arg) {
+    syscalls++;
+    if (ioctlFunction) return ioctlFunction(fd, request, arg);
+    return ioctl(fd, request, arg);
+}
+
+/**
+ * Setting the sampling rate specified in the config register
+ * @param samplingRate It's the sampling rate: RATE_8SPS, RATE_16SPS, RATE_32SPS, RATE_64SPS, RATE_128SPS, RATE_250SPS, RATE_475SPS, RATE_860SPS
+ */
+void ADS1118Spidev::setSamplingRate(uint8_t samplingRate) {
+    configRegister.bits.rate = samplingRate;
+}
+
+/**
+ * Setting the full scale range in the config register
+ * @param fsr The full scale range: FSR_6144 (±6.144V)*, FSR_4096(±4.096V)*, FSR_2048(±2.048V), FSR_1024(±1.024V), FSR_0512(±0.512V), FSR_0256(±0.256V). (*) No more than VDD + 0.3 V must be applied to this device.
+ */
+void ADS1118Spidev::setFullScaleRange(uint8_t fsr) {
+    configRegister.bits.pga = fsr;
+}
+
+/**
+ * Number of frames whose config echo didn't match the frame written since the start
+ * @return The number of corrupted frames
+ */
+uint32_t ADS1118Spidev::getFrameErrors() {
+    return frameErrors;
+}
+
+/**
+ * Setting how many extra scans can be made when a config echo doesn't match
+ * @param retries Number of extra scans (0: no retries). Default: 2
+ */
+void ADS1118Spidev::setMaxRetries(uint8_t retries) {
+    maxRetries = retries;
+}
+
+/**
+ * Number of ioctl() calls made since begin(), including the ones made by begin()
+ * @return The number of system calls
+ */
+uint32_t ADS1118Spidev::getSyscalls() {
+    return syscalls;
+}
+
+#endif
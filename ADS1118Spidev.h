@@ -0,0 +1,89 @@
+#ifndef ADS1118Spidev_h
+#define ADS1118Spidev_h
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <stdint.h>
+#include <linux/spi/spidev.h>
+#include "ADS1118Config.h"
+
+/**
+ * Linux (spidev) backend for the ADS1118.
+ * A complete multi-channel scan is sent to the kernel as a single SPI_IOC_MESSAGE:
+ * one 32-bit frame per conversion, the conversion waits are encoded as delay_usecs
+ * and CS is toggled between frames with cs_change. Frame i writes the config of
+ * inputs[i] and reads back the conversion started by frame i-1, so a scan of
+ * N inputs takes N+1 frames and exactly one ioctl() call. The config echoed in every
+ * frame is checked and the scan is repeated (up to setMaxRetries()) on a mismatch.
+ * The ioctl() function can be replaced to simulate the device without hardware.
+ * @author Alvaro Salazar <alvaro@denkitronik.com>
+ */
+class ADS1118Spidev {
+    public:
+        typedef int (*IoctlFunction)(int fd, unsigned long request, void *arg);	///< Signature of ioctl()
+        ADS1118Spidev(const char *device, IoctlFunction ioctlFunction=0);	///< Constructor
+        ~ADS1118Spidev();					///< Destructor: closing the device if it was opened by begin()
+        bool begin();						///< Opening the spidev device and setting the SPI mode, word size and SCLK
+        bool begin(int fd);					///< Using an already opened spidev file descriptor
+        void end();							///< Closing the device
+        bool scan(const uint8_t *inputs, uint8_t count, uint16_t *values, bool *valid=0);	///< Getting one sample of each input with a single ioctl() call
+        void setSamplingRate(uint8_t samplingRate);	///< Setting the sampling rate specified in the config register
+        void setFullScaleRange(uint8_t fsr);///< Setting the full scale range in the config register
+        uint32_t getSyscalls();				///< Number of ioctl() calls made since begin()
+        uint32_t getFrameErrors();			///< Number of frames whose config echo didn't match
+        void setMaxRetries(uint8_t retries);///< Setting the extra scans allowed when an echo doesn't match
+        union Config configRegister;		///< Config register
+
+        static const uint32_t SCLK = 2000000;	///< ADS1118 SCLK frequency: 4000000 Hz Maximum for ADS1118
+        static const uint8_t MAX_INPUTS = 16;	///< Maximum number of inputs in a scan (inputs can be repeated)
+
+        //Input multiplexer configuration selection for bits "MUX" (same values as the ADS1118 class)
+        static const uint8_t DIFF_0_1 = 0b000;	///< Differential input: Vin=A0-A1
+        static const uint8_t DIFF_0_3 = 0b001;	///< Differential input: Vin=A0-A3
+        static const uint8_t DIFF_1_3 = 0b010;	///< Differential input: Vin=A1-A3
+        static const uint8_t DIFF_2_3 = 0b011;	///< Differential input: Vin=A2-A3
+        static const uint8_t AIN_0    = 0b100;	///< Single ended input: Vin=A0
+        static const uint8_t AIN_1    = 0b101;	///< Single ended input: Vin=A1
+        static const uint8_t AIN_2    = 0b110;	///< Single ended input: Vin=A2
+        static const uint8_t AIN_3    = 0b111;	///< Single ended input: Vin=A3
+
+        //Full scale range (FSR) selection by "PGA" bits
+        static const uint8_t FSR_6144 = 0b000;	///< Range: ±6.144 v. LSB SIZE = 187.5μV
+        static const uint8_t FSR_4096 = 0b001;	///< Range: ±4.096 v. LSB SIZE = 125μV
+        static const uint8_t FSR_2048 = 0b010;	///< Range: ±2.048 v. LSB SIZE = 62.5μV ***DEFAULT
+        static const uint8_t FSR_1024 = 0b011;	///< Range: ±1.024 v. LSB SIZE = 31.25μV
+        static const uint8_t FSR_0512 = 0b100;	///< Range: ±0.512 v. LSB SIZE = 15.625μV
+        static const uint8_t FSR_0256 = 0b111;	///< Range: ±0.256 v. LSB SIZE = 7.8125μV
+
+        //Sampling rate selection by "DR" bits
+        static const uint8_t RATE_8SPS   = 0b000;	///< 8 samples/s, Tconv=125ms
+        static const uint8_t RATE_16SPS  = 0b001;	///< 16 samples/s, Tconv=62.5ms
+        static const uint8_t RATE_32SPS  = 0b010;	///< 32 samples/s, Tconv=31.25ms
+        static const uint8_t RATE_64SPS  = 0b011;	///< 64 samples/s, Tconv=15.625ms
+        static const uint8_t RATE_128SPS = 0b100;	///< 128 samples/s, Tconv=7.8125ms
+        static const uint8_t RATE_250SPS = 0b101;	///< 250 samples/s, Tconv=4ms
+        static const uint8_t RATE_475SPS = 0b110;	///< 475 samples/s, Tconv=2.105ms
+        static const uint8_t RATE_860SPS = 0b111;	///< 860 samples/s, Tconv=1.163ms
+
+    private:
+        bool transferScan(const uint8_t *inputs, uint8_t count, uint16_t *values, bool *valid);
+        uint16_t addTransfer(uint16_t index, uint8_t *tx, uint8_t *rx, uint32_t waitUs);
+        int doIoctl(unsigned long request, void *arg);
+        const char *device;					///< Path of the spidev device. Example: /dev/spidev0.0
+        IoctlFunction ioctlFunction;		///< ioctl() or a replacement for it
+        int fd;								///< spidev file descriptor
+        bool ownsFd;						///< True if fd was opened by begin()
+        uint32_t syscalls;					///< Number of ioctl() calls
+        uint32_t frameErrors;				///< Frames whose config echo didn't match
+        uint8_t maxRetries;					///< Extra scans allowed when an echo doesn't match
+        uint8_t txFrames[MAX_INPUTS+1][4];	///< Frames to be written (config, config)
+        uint8_t rxFrames[MAX_INPUTS+1][4];	///< Frames read (data, config echo)
+        ///Every frame plus the zero length transfers needed to wait 8SPS conversions (delay_usecs is 16 bits)
+        struct spi_ioc_transfer transfers[(MAX_INPUTS+1)*4];
+        static const uint16_t ECHO_MASK = 0x7FF8;	///< Config bits compared with the echo (SS, NOP and Reserved don't read back as written)
+        static const uint32_t CONV_TIME_US[8];	///< Conversion times in μs, including the ±10% oscillator tolerance
+};
+
+#endif
+
+#endif
@@ -0,0 +1,137 @@
+/**
+*  Streaming statistics for the Arduino Library for Texas Instruments ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+
+/**
+ * The MIT License
+ *
+ * Copyright 2018 Alvaro Salazar <alvaro@denkitronik.com>.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ADS1118Stats.h"
+#include <math.h>
+
+/**
+ * Constructor of the class
+ * @param windowSize Samples per window. 0 means that the samples are accumulated until reset() is called
+ * @param windowMode TUMBLING or SLIDING
+ */
+ADS1118Stats::ADS1118Stats(uint32_t windowSize, uint8_t windowMode) {
+    this->windowSize = windowSize;
+    this->windowMode = windowMode;
+    reset();
+}
+
+/**
+ * Discarding every accumulated sample
+ */
+void ADS1118Stats::reset() {
+    clearPane(current);
+    clearPane(previous);
+    shift = 0;
+    shifted = false;
+}
+
+/**
+ * Adding a sample. Only integer operations are made here
+ * @param code The code returned by getADCValue() (binary twos complement format)
+ */
+void ADS1118Stats::add(uint16_t code) {
+    int16_t value = (int16_t)code;
+    if (!shifted) {     //The first sample is the reference: sums stay small and exact
+        shift = value;
+        shifted = true;
+    }
+    if (windowSize>0 && current.count>=windowSize) {   //Window full: starting a new one
+        if (windowMode==SLIDING)
+            previous = current;
+        clearPane(current);
+    }
+    int32_t delta = (int32_t)value - shift;
+    uint32_t magnitude = (delta<0) ? -delta : delta;   //|delta|<=65535 so its square fits in 32 bits
+    if (current.count==0 || value<current.min) current.min = value;
+    if (current.count==0 || value>current.max) current.max = value;
+    current.sum += delta;
+    current.sumSquares += magnitude*magnitude;
+    current.count++;
+}
+
+/**
+ * Getting the statistics of the current window (both panes in SLIDING mode)
+ * @param summary Reference to the summary to be filled
+ * @return False if there are no samples in the window
+ */
+bool ADS1118Stats::snapshot(ADS1118Summary &summary) {
+    Pane pane = current;
+    if (windowMode==SLIDING && previous.count>0) {     //Merging the panes: they share the same shift
+        if (pane.count==0 || previous.min<pane.min) pane.min = previous.min;
+        if (pane.count==0 || previous.max>pane.max) pane.max = previous.max;
+        pane.count += previous.count;
+        pane.sum += previous.sum;
+        pane.sumSquares += previous.sumSquares;
+    }
+    if (pane.count==0) return false;
+    double n = pane.count;
+    double meanDelta = pane.sum/n;
+    double variance = (pane.sumSquares - pane.sum*meanDelta)/n;
+    if (variance<0) variance = 0;   //Rounding could give a tiny negative value
+    double mean = shift + meanDelta;
+    summary.count = pane.count;
+    summary.min = pane.min;
+    summary.max = pane.max;
+    summary.mean = mean;
+    summary.variance = variance;
+    summary.rms = sqrt(variance + mean*mean);
+    return true;
+}
+
+/**
+ * True once the current window holds windowSize samples. Take the snapshot before the next add()
+ * @return False if windowSize is 0 or the window is not full yet
+ */
+bool ADS1118Stats::windowComplete() {
+    return windowSize>0 && current.count>=windowSize;
+}
+
+/**
+ * Number of samples in the current window
+ * @return The number of samples added since the window started
+ */
+uint32_t ADS1118Stats::getCount() {
+    return current.count;
+}
+
+/**
+ * Clearing the partial sums of a pane
+ * @param pane The pane to be cleared
+ */
+void ADS1118Stats::clearPane(Pane &pane) {
+    pane.count = 0;
+    pane.min = 0;
+    pane.max = 0;
+    pane.sum = 0;
+    pane.sumSquares = 0;
+}
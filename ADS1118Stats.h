@@ -0,0 +1,66 @@
+#ifndef ADS1118Stats_h
+#define ADS1118Stats_h
+
+#include <stdint.h>
+
+/**
+ * Summary of the samples accumulated by an ADS1118Stats object.
+ * All the values are expressed in ADC codes (LSB). Multiply them by the LSB size
+ * of the FSR in use (see FSR_* constants) to get volts.
+ */
+struct ADS1118Summary {
+    uint32_t count;     ///< Number of samples in the window
+    int16_t  min;       ///< Minimum code in the window
+    int16_t  max;       ///< Maximum code in the window
+    float    mean;      ///< Mean value in LSB
+    float    variance;  ///< Population variance in LSB^2
+    float    rms;       ///< Root mean square in LSB
+};
+
+
+/**
+ * Streaming statistics (min, max, mean, variance and RMS) of one ADS1118 channel.
+ * Samples are accumulated with integer arithmetic only: every code is shifted by the
+ * first code of the run (shifted-data algorithm, numerically equivalent to Welford's)
+ * so the sums stay exact and small, and floats are only used by snapshot().
+ * Memory usage is constant: create one object per channel you want to monitor.
+ *
+ * Window modes:
+ *   - windowSize=0: accumulates until reset() is called.
+ *   - TUMBLING: the window is restarted every windowSize samples.
+ *   - SLIDING: two panes of windowSize samples are kept, the snapshot covers
+ *     the last windowSize to 2*windowSize samples.
+ * @author Alvaro Salazar <alvaro@denkitronik.com>
+ */
+class ADS1118Stats {
+    public:
+        ADS1118Stats(uint32_t windowSize=0, uint8_t windowMode=0);	///< Constructor
+        void add(uint16_t code);		///< Adding a sample (code returned by getADCValue())
+        void reset();					///< Discarding every accumulated sample
+        bool snapshot(ADS1118Summary &summary);	///< Getting the statistics of the current window
+        bool windowComplete();			///< True once the current window holds windowSize samples
+        uint32_t getCount();			///< Number of samples in the current window
+
+        // Used by "windowMode"
+        static const uint8_t TUMBLING = 0;	///< Non overlapping windows of windowSize samples ***DEFAULT
+        static const uint8_t SLIDING  = 1;	///< Overlapping windows of windowSize to 2*windowSize samples
+
+    private:
+        ///Partial sums of a set of samples, all of them relative to "shift"
+        struct Pane {
+            uint32_t count;		///< Number of samples
+            int16_t  min;		///< Minimum code
+            int16_t  max;		///< Maximum code
+            int64_t  sum;		///< Sum of (code-shift)
+            uint64_t sumSquares;///< Sum of (code-shift)^2
+        };
+        void clearPane(Pane &pane);
+        Pane current;			///< Pane receiving the samples
+        Pane previous;			///< Last completed pane (SLIDING mode only)
+        int16_t shift;			///< First code received after reset()
+        bool shifted;			///< True when "shift" holds a valid code
+        uint32_t windowSize;	///< Samples per window (0: no window)
+        uint8_t windowMode;		///< TUMBLING or SLIDING
+};
+
+#endif
@@ -0,0 +1,72 @@
+/**
+*  Planner Example for Arduino Library for Texas Instruments ADS1118 - 16-Bit Analog-to-Digital Converter with
+*  Internal Reference and Temperature Sensor
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118.h"
+#include <SPI.h>
+
+//Definition of the Arduino pin to be used as the chip select pin (SPI CS pin). Example: pin 5
+#define CS 5
+
+//Creating an ADS1118 object (object's name is ads1118)
+ADS1118 ads1118(CS);
+
+//Requirements: 100μV peak-to-peak noise, inputs up to ±1.5V, 2 channels, one reading of both channels every 100ms
+ADS1118Plan plan=ADS1118Noise::plan(100, 1500, 2, 100);
+
+const uint8_t READINGS=20;  //Readings of each channel measured by the benchmark
+
+
+/**
+ * Getting the average of "oversampling" readings of an input
+ */
+double getAverage(uint8_t input, uint16_t oversampling){
+    double sum=0;
+    for (uint16_t i=0;i<oversampling;i++)
+        sum+=ads1118.getMilliVolts(input);
+    return sum/oversampling;
+}
+
+
+/**
+ * Measuring the readings per second of each channel with the current configuration
+ */
+float benchmark(uint16_t oversampling){
+    unsigned long start=millis();
+    for (uint8_t i=0;i<READINGS;i++){
+        getAverage(ads1118.AIN_0, oversampling);
+        getAverage(ads1118.AIN_1, oversampling);
+    }
+    return READINGS*1000.0/(millis()-start);
+}
+
+
+void setup(){
+    Serial.begin(115200);
+    ads1118.begin(); //Initialize the ADS1118. Default setting: PULLUP RESISTOR, ADC MODE, RATE 8SPS, SINGLE SHOT, ±0.256V, DIFFERENTIAL AIN0-AIN1
+    if (!plan.feasible){
+        Serial.println("No configuration meets the requirements");
+        return;
+    }
+    Serial.println("Plan: "+String(ADS1118Noise::samplesPerSecond(plan.rate))+"SPS, FSR code "+String(plan.fsr)+", "+String(plan.oversampling)+" samples averaged");
+    Serial.println("Expected: "+String(plan.noiseMicroVolts,2)+"uVpp, "+String(plan.readingsPerSecond,2)+" readings/s per channel, "+String(plan.latencyMs,2)+"ms per scan");
+
+    //Default configuration meeting the same range: 8SPS without oversampling
+    ads1118.setFullScaleRange(plan.fsr);
+    Serial.println("Default: "+String(benchmark(1),2)+" readings/s per channel");
+
+    ads1118.applyPlan(plan);
+    Serial.println("Planned: "+String(benchmark(plan.oversampling),2)+" readings/s per channel");
+}
+
+
+void loop(){
+    if (!plan.feasible) return;
+    Serial.print(String(getAverage(ads1118.AIN_0, plan.oversampling),4)+"mV ");
+    Serial.println(String(getAverage(ads1118.AIN_1, plan.oversampling),4)+"mV");
+}
@@ -0,0 +1,66 @@
+/**
+*  Statistics Example for Arduino Library for Texas Instruments ADS1118 - 16-Bit Analog-to-Digital Converter with
+*  Internal Reference and Temperature Sensor
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118.h"
+#include "ADS1118Stats.h"
+#include <SPI.h>
+
+//Definition of the Arduino pin to be used as the chip select pin (SPI CS pin). Example: pin 5
+#define CS 5
+
+//Creating an ADS1118 object (object's name is ads1118)
+ADS1118 ads1118(CS);
+
+//One statistics object per channel. Each window holds 32 samples (about one second per channel at 64SPS with 2 channels)
+ADS1118Stats statsAin0(32);
+ADS1118Stats statsAin1(32);
+
+unsigned long addTime=0;    //Time spent in add() (microseconds)
+unsigned long addCount=0;   //Number of calls to add()
+
+
+void setup(){
+    Serial.begin(115200);
+    ads1118.begin(); //Initialize the ADS1118. Default setting: PULLUP RESISTOR, ADC MODE, RATE 8SPS, SINGLE SHOT, ±0.256V, DIFFERENTIAL AIN0-AIN1
+    ads1118.setSamplingRate(ads1118.RATE_64SPS);
+    ads1118.setFullScaleRange(ads1118.FSR_2048);
+}
+
+
+/**
+ * Printing the summary of a window. The LSB size of FSR_2048 is 62.5μV
+ */
+void printSummary(const char *name, ADS1118Stats &stats){
+    ADS1118Summary summary;
+    if (!stats.snapshot(summary)) return;
+    const float lsb=0.0625;  //mV
+    Serial.print(name);
+    Serial.print(" n="+String(summary.count));
+    Serial.print(" min="+String(summary.min*lsb,4)+"mV");
+    Serial.print(" max="+String(summary.max*lsb,4)+"mV");
+    Serial.print(" mean="+String(summary.mean*lsb,4)+"mV");
+    Serial.print(" std="+String(sqrt(summary.variance)*lsb,4)+"mV");
+    Serial.println(" rms="+String(summary.rms*lsb,4)+"mV");
+}
+
+
+void loop(){
+    uint16_t ain0=ads1118.getADCValue(ads1118.AIN_0);
+    uint16_t ain1=ads1118.getADCValue(ads1118.AIN_1);
+    unsigned long start=micros();
+    statsAin0.add(ain0);
+    statsAin1.add(ain1);
+    addTime+=micros()-start;
+    addCount+=2;
+    if (statsAin0.windowComplete()) {  //Both windows are filled at the same pace
+        printSummary("AIN0", statsAin0);
+        printSummary("AIN1", statsAin1);
+        Serial.println("add() cost: "+String((float)addTime/addCount,2)+"us/sample");
+    }
+}
@@ -0,0 +1,192 @@
+/**
+*  Host benchmark of the Arduino Library for Texas Instruments ADS1118
+*
+*  Every read path is run at every data rate against a SimulatedADS1118. Frames, bus time and
+*  elapsed time come from the simulated chip (virtual time); CPU time is the thread CPU time of
+*  the host spent in the library calls. The results are printed to stdout as one JSON document.
+*
+*  Usage: ads1118_benchmark [samples per test]
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118.h"
+#include "SimulatedADS1118.h"
+#include "HostBenchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define CS 5
+#define DRDY 19
+
+static const float TEMPERATURE=25.5;
+static const uint32_t POLL_US=20;       //Wait between two DRDY polls of the NoWait methods
+
+//Read paths
+enum {ADC_VALUE, MILLIVOLTS, MILLIVOLTS_SETTLED, TEMPERATURE_READ, MIXED, ADC_VALUE_NOWAIT, MILLIVOLTS_NOWAIT, METHOD_COUNT};
+static const char *METHODS[]={"getADCValue", "getMilliVolts(inputs)", "getMilliVolts()", "getTemperature", "getMilliVolts(inputs)+getTemperature", "getADCValueNoWait", "getMilliVoltsNoWait"};
+
+//Channel patterns
+enum {SAME, ALTERNATE};
+static const char *PATTERNS[]={"same", "alternate"};
+
+static volatile double sink;            //Keeps the compiler from removing the readings
+static bool firstResult=true;
+
+
+/**
+ * Taking one sample with the method and channel pattern given
+ * @param ready Set to false if the sample wasn't ready (NoWait methods)
+ * @return True if the sample is the value expected from the simulated inputs
+ */
+static bool readSample(ADS1118 &ads1118, SimulatedADS1118 &chip, uint8_t method, uint8_t pattern, uint32_t i, bool &ready){
+    uint8_t input=(pattern==ALTERNATE && (i&1)) ? ads1118.AIN_1 : ads1118.AIN_0;
+    uint16_t expected=chip.codeFor(input, ads1118.configRegister.bits.pga);
+    ready=true;
+    switch(method){
+        case ADC_VALUE: {
+            uint16_t value=ads1118.getADCValue(input);
+            sink=value;
+            return value==expected;
+        }
+        case MILLIVOLTS: {
+            double volts=ads1118.getMilliVolts(input);
+            sink=volts;
+            return volts==ads1118.toMilliVolts(expected);
+        }
+        case MILLIVOLTS_SETTLED: {
+            double volts=ads1118.getMilliVolts();
+            sink=volts;
+            return volts==ads1118.toMilliVolts(chip.codeFor(ads1118.configRegister.bits.mux, ads1118.configRegister.bits.pga));
+        }
+        case TEMPERATURE_READ: {
+            double celsius=ads1118.getTemperature();
+            sink=celsius;
+            return celsius==TEMPERATURE;
+        }
+        case MIXED:
+            if (i&1) {
+                double celsius=ads1118.getTemperature();
+                sink=celsius;
+                return celsius==TEMPERATURE;
+            } else {
+                double volts=ads1118.getMilliVolts(input);
+                sink=volts;
+                return volts==ads1118.toMilliVolts(expected);
+            }
+        case ADC_VALUE_NOWAIT: {
+            uint16_t value;
+            ready=ads1118.getADCValueNoWait(DRDY, value);
+            sink=value;
+            return !ready || value==chip.codeFor(ads1118.AIN_0, ads1118.configRegister.bits.pga);
+        }
+        case MILLIVOLTS_NOWAIT: {
+            double volts;
+            ready=ads1118.getMilliVoltsNoWait(DRDY, volts);
+            sink=volts;
+            return !ready || fabs(volts-ads1118.toMilliVolts(chip.codeFor(ads1118.AIN_0, ads1118.configRegister.bits.pga)))<0.001;  //The NoWait math scales in double
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Measuring a read path and printing its result as a JSON object
+ */
+static void runTest(ADS1118 &ads1118, SimulatedADS1118 &chip, uint8_t method, uint8_t pattern, uint8_t rate, uint32_t samples){
+    uint32_t taken=0, wrong=0, polls=0;
+    uint64_t callCpuNs=0;
+    uint32_t frames=chip.getFrames();
+    uint32_t errors=ads1118.getFrameErrors();
+    uint32_t conversions=chip.getConversions();
+    uint64_t busNs=chip.getBusNs();
+    uint64_t start=chip.now();
+    while (taken<samples){
+        bool ready;
+        uint64_t callStart=cpuNs();
+        bool right=readSample(ads1118, chip, method, pattern, taken, ready);
+        callCpuNs+=cpuNs()-callStart;
+        if (!ready){
+            polls++;
+            delayMicroseconds(POLL_US);
+            continue;
+        }
+        if (!right) wrong++;
+        taken++;
+    }
+    uint64_t elapsedNs=chip.now()-start;
+    busNs=chip.getBusNs()-busNs;
+    frames=chip.getFrames()-frames;
+    errors=ads1118.getFrameErrors()-errors;
+    conversions=chip.getConversions()-conversions;
+
+    if (!firstResult) printf(",\n");
+    firstResult=false;
+    printf("    {\"method\": \"%s\", \"pattern\": \"%s\", \"rate_sps\": %u", METHODS[method], PATTERNS[pattern], ADS1118Noise::samplesPerSecond(rate));
+    printf(", \"samples\": %u, \"wrong_values\": %u, \"frames\": %u, \"frame_errors\": %u, \"conversions\": %u, \"drdy_polls\": %u",
+           taken, wrong, frames, errors, conversions, polls);
+    printf(", \"bus_us\": %.3f, \"wait_us\": %.3f, \"elapsed_us\": %.3f",
+           busNs/1000.0, (elapsedNs-busNs)/1000.0, elapsedNs/1000.0);
+    printf(", \"samples_per_second\": %.3f, \"cpu_ns_per_sample\": %.1f, \"cpu_ns_per_call\": %.1f}",
+           taken*1e9/elapsedNs, (double)callCpuNs/taken, (double)callCpuNs/(taken+polls));
+}
+
+
+/**
+ * Measuring the conversion math of getMilliVolts() alone (toMilliVolts() over every code)
+ */
+static void runConversionMath(ADS1118 &ads1118){
+    const uint32_t ROUNDS=64;
+    double sum=0;
+    uint64_t start=cpuNs();
+    for (uint32_t round=0; round<ROUNDS; round++)
+        for (uint32_t code=0; code<=0xFFFF; code++)
+            sum+=ads1118.toMilliVolts((uint16_t)code);
+    uint64_t used=cpuNs()-start;
+    sink=sum;
+    printf(",\n    {\"method\": \"toMilliVolts\", \"conversions\": %u, \"cpu_ns_per_conversion\": %.3f}",
+           ROUNDS*0x10000, (double)used/(ROUNDS*0x10000));
+}
+
+
+int main(int argc, char **argv){
+    uint32_t samples=argc>1 ? strtoul(argv[1], 0, 10) : 16;
+    if (samples==0) samples=1;
+    SimulatedADS1118 chip;
+    hostAttach(&chip, CS);
+    ADS1118 ads1118(CS);
+    ads1118.begin();
+    chip.setInput(ads1118.AIN_0, 1234.5);
+    chip.setInput(ads1118.AIN_1, -321.25);
+    chip.setTemperature(TEMPERATURE);
+    ads1118.setInputSelected(ads1118.AIN_0);
+    ads1118.setFullScaleRange(ads1118.FSR_2048);
+
+    printf("{\n");
+    printf("  \"library\": \"ADS1118\",\n");
+    printf("  \"board\": \"host-simulated\",\n");
+    printf("  \"sclk_hz\": %u,\n", ads1118.SCLK);
+    printf("  \"samples_per_test\": %u,\n", samples);
+    printf("  \"results\": [\n");
+    for (uint8_t rate=0; rate<8; rate++){
+        ads1118.setSamplingRate(rate);
+        for (uint8_t method=ADC_VALUE; method<METHOD_COUNT; method++){
+            bool noWait=(method==ADC_VALUE_NOWAIT || method==MILLIVOLTS_NOWAIT);
+            if (noWait){    //The NoWait methods read the conversions of the settled input in continuous mode
+                ads1118.setContinuousMode();
+                ads1118.getADCValue(ads1118.AIN_0);
+            }
+            runTest(ads1118, chip, method, SAME, rate, samples);
+            if (method==ADC_VALUE || method==MILLIVOLTS || method==MIXED)
+                runTest(ads1118, chip, method, ALTERNATE, rate, samples);
+            if (noWait) ads1118.setSingleShotMode();
+        }
+    }
+    runConversionMath(ads1118);
+    printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+*  Host benchmark of ADS1118Noise::plan(): readings per second predicted by the plan, measured
+*  with the ADS1118 class on the simulated chip and measured with the default configuration
+*  (8 SPS, smallest FSR covering the range, no averaging), printed as JSON
+*
+*  Usage: ads1118_noise_benchmark [readings per test]
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118.h"
+#include "SimulatedADS1118.h"
+#include "HostBenchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CS 5
+
+///Requirements given to the planner
+struct Requirement {
+    float resolutionMicroVolts;
+    float rangeMilliVolts;
+    uint8_t channels;
+    float latencyMs;
+};
+
+static const Requirement REQUIREMENTS[] = {
+    {16.1, 200, 1, 0}, {100, 1500, 2, 100}, {10, 200, 3, 0}, {20, 500, 4, 0}, {200, 5000, 4, 50}, {40, 1000, 8, 0}
+};
+
+/**
+ * Averaged readings per second of each channel measured on the simulated chip
+ */
+static double measure(uint8_t rate, uint8_t fsr, uint16_t oversampling, uint8_t channels, uint32_t readings) {
+    SimulatedADS1118 chip;
+    hostAttach(&chip, CS);
+    ADS1118 ads1118(CS);
+    ads1118.begin();
+    ads1118.setSamplingRate(rate);
+    ads1118.setFullScaleRange(fsr);
+    uint64_t start = chip.now();
+    for (uint32_t r = 0; r < readings; r++)
+        for (uint8_t channel = 0; channel < channels; channel++)
+            for (uint16_t i = 0; i < oversampling; i++)
+                ads1118.getMilliVolts(ads1118.AIN_0 + (channel & 3));
+    double seconds = (chip.now() - start)/1e9;
+    hostAttach(0, CS);
+    return readings/seconds;
+}
+
+int main(int argc, char **argv) {
+    uint32_t readings = argc > 1 ? strtoul(argv[1], 0, 10) : 10;
+    if (readings == 0) readings = 1;
+    const uint32_t PLANS = 10000;
+    printf("{\n  \"class\": \"ADS1118Noise\",\n  \"readings_per_test\": %u,\n  \"results\": [\n", readings);
+    size_t count = sizeof(REQUIREMENTS)/sizeof(REQUIREMENTS[0]);
+    for (size_t r = 0; r < count; r++) {
+        const Requirement &requirement = REQUIREMENTS[r];
+        uint64_t start = cpuNs();
+        ADS1118Plan plan;
+        for (uint32_t i = 0; i < PLANS; i++)
+            plan = ADS1118Noise::plan(requirement.resolutionMicroVolts, requirement.rangeMilliVolts, requirement.channels, requirement.latencyMs);
+        double planNs = (double)(cpuNs() - start)/PLANS;
+        printf("    {\"resolution_uv\": %.2f, \"range_mv\": %.0f, \"channels\": %u, \"latency_ms\": %.0f, \"feasible\": %s",
+               requirement.resolutionMicroVolts, requirement.rangeMilliVolts, requirement.channels, requirement.latencyMs, plan.feasible ? "true" : "false");
+        if (plan.feasible) {
+            int8_t f = ADS1118Noise::FSR_COUNT - 1;    //Default FSR: the smallest one covering the range
+            while (f > 0 && ADS1118Noise::fullScaleMilliVolts(ADS1118Noise::fsrCode(f)) < requirement.rangeMilliVolts) f--;
+            uint8_t fsr = ADS1118Noise::fsrCode(f);
+            printf(", \"rate_sps\": %u, \"fsr_mv\": %u, \"oversampling\": %u, \"noise_uv\": %.2f",
+                   ADS1118Noise::samplesPerSecond(plan.rate), ADS1118Noise::fullScaleMilliVolts(plan.fsr), plan.oversampling, plan.noiseMicroVolts);
+            printf(", \"chip_only_readings_per_second\": %.3f, \"predicted_readings_per_second\": %.3f",
+                   (double)ADS1118Noise::samplesPerSecond(plan.rate)/(plan.oversampling*requirement.channels), plan.readingsPerSecond);
+            printf(", \"measured_readings_per_second\": %.3f, \"default_readings_per_second\": %.3f",
+                   measure(plan.rate, plan.fsr, plan.oversampling, requirement.channels, readings),
+                   measure(0, fsr, 1, requirement.channels, readings));
+        }
+        printf(", \"plan_cpu_ns\": %.1f}%s\n", planNs, r + 1 < count ? "," : "");
+    }
+    printf("  ]\n}\n");
+    return 0;
+}
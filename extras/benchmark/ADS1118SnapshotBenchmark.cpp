@@ -0,0 +1,80 @@
+/**
+*  Host benchmark of ADS1118Snapshot: latency of read() with and without a publisher
+*  writing the same entry, and cost of publish(), printed as JSON
+*
+*  Usage: ads1118_snapshot_benchmark [reads per test]
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118Snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+static volatile uint32_t sink;     //Keeps the compiler from removing the readings
+
+/**
+ * Monotonic time
+ * @return The time in ns
+ */
+static uint64_t nowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec*1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * Measuring read() on channel 0: mean of a batch and percentiles of individually timed reads
+ */
+static void runReads(const char *name, ADS1118Snapshot &snapshot, uint32_t reads, bool last) {
+    ADS1118Reading reading;
+    uint64_t start = nowNs();
+    for (uint32_t i = 0; i < reads; i++) {
+        snapshot.read(0, reading);
+        sink = reading.sequence;
+    }
+    double meanNs = (double)(nowNs() - start)/reads;
+    std::vector<uint32_t> latencies(reads);
+    for (uint32_t i = 0; i < reads; i++) {
+        uint64_t before = nowNs();
+        snapshot.read(0, reading);
+        latencies[i] = (uint32_t)(nowNs() - before);
+        sink = reading.sequence;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    printf("    {\"test\": \"%s\", \"reads\": %u, \"read_ns_mean\": %.2f, \"read_ns_p50\": %u, \"read_ns_p99\": %u, \"read_ns_max\": %u}%s\n",
+           name, reads, meanNs, latencies[reads/2], latencies[reads*99/100], latencies[reads - 1], last ? "" : ",");
+}
+
+int main(int argc, char **argv) {
+    uint32_t reads = argc > 1 ? strtoul(argv[1], 0, 10) : 1000000;
+    if (reads == 0) reads = 1;
+    ADS1118Snapshot snapshot;
+    printf("{\n  \"class\": \"ADS1118Snapshot\",\n  \"results\": [\n");
+
+    uint64_t start = nowNs();
+    for (uint32_t i = 0; i < reads; i++) snapshot.publish(0, (uint16_t)i, (float)i, i);
+    printf("    {\"test\": \"publish\", \"publishes\": %u, \"publish_ns_mean\": %.2f},\n", reads, (double)(nowNs() - start)/reads);
+
+    runReads("read_idle", snapshot, reads, false);
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> published(0);
+    std::thread publisher([&]() {
+        uint32_t n = 0;
+        while (!done.load(std::memory_order_relaxed)) snapshot.publish(0, (uint16_t)n, (float)n, n), n++;
+        published = n;
+    });
+    runReads("read_while_publishing", snapshot, reads, true);
+    done = true;
+    publisher.join();
+    printf("  ],\n  \"publishes_during_contended_reads\": %u\n}\n", published.load());
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+*  Host benchmark of ADS1118Spidev: system calls, transfers and time per scan through the
+*  mock spidev driver, printed as JSON
+*
+*  Usage: ads1118_spidev_benchmark [scans per test]
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118Spidev.h"
+#include "MockSpidev.h"
+#include "SimulatedADS1118.h"
+#include "ADS1118Noise.h"
+#include "HostBenchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FD 3
+
+static const uint8_t COUNTS[]={1, 2, 4, 8, 16};
+
+int main(int argc, char **argv){
+    uint32_t scans=argc>1 ? strtoul(argv[1], 0, 10) : 100;
+    if (scans==0) scans=1;
+    SimulatedADS1118 chip;
+    MockSpidev mock(chip);
+    ADS1118Spidev ads1118("/dev/spidev0.0", MockSpidev::ioctl);
+    if (!ads1118.begin(FD)) return 1;
+    uint8_t inputs[ADS1118Spidev::MAX_INPUTS];
+    uint16_t values[ADS1118Spidev::MAX_INPUTS];
+    bool valid[ADS1118Spidev::MAX_INPUTS];
+    for (uint8_t i=0; i<ADS1118Spidev::MAX_INPUTS; i++) inputs[i]=ADS1118Spidev::AIN_0+(i&3);
+
+    printf("{\n  \"class\": \"ADS1118Spidev\",\n  \"sclk_hz\": %u,\n  \"scans_per_test\": %u,\n  \"results\": [\n", ADS1118Spidev::SCLK, scans);
+    bool first=true;
+    for (uint8_t rate=0; rate<8; rate++){
+        ads1118.setSamplingRate(rate);
+        for (uint8_t c=0; c<sizeof(COUNTS); c++){
+            uint8_t count=COUNTS[c];
+            uint32_t syscalls=ads1118.getSyscalls();
+            uint32_t transfers=mock.getTransfers();
+            uint32_t frames=chip.getFrames();
+            uint32_t invalid=0;
+            uint64_t start=chip.now();
+            uint64_t cpu=0;
+            for (uint32_t s=0; s<scans; s++){
+                uint64_t callStart=cpuNs();
+                ads1118.scan(inputs, count, values, valid);
+                cpu+=cpuNs()-callStart;
+                for (uint8_t i=0; i<count; i++) if (!valid[i]) invalid++;
+            }
+            double elapsedNs=chip.now()-start;
+            syscalls=ads1118.getSyscalls()-syscalls;
+            transfers=mock.getTransfers()-transfers;
+            frames=chip.getFrames()-frames;
+            printf("%s    {\"rate_sps\": %u, \"inputs\": %u, \"syscalls_per_scan\": %.3f, \"frames_per_scan\": %.3f",
+                   first ? "" : ",\n", ADS1118Noise::samplesPerSecond(rate), count, (double)syscalls/scans, (double)frames/scans);
+            printf(", \"syscalls_one_frame_per_call\": %.3f, \"transfers_per_scan\": %.3f, \"invalid_values\": %u",
+                   (double)frames/scans, (double)transfers/scans, invalid);
+            printf(", \"scan_us\": %.3f, \"samples_per_second\": %.3f, \"cpu_ns_per_scan\": %.1f}",
+                   elapsedNs/scans/1000, count*scans*1e9/elapsedNs, (double)cpu/scans);
+            first=false;
+        }
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
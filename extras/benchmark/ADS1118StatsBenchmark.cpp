@@ -0,0 +1,54 @@
+/**
+*  Host benchmark of ADS1118Stats: CPU time of add() per sample and of snapshot(), printed as JSON
+*
+*  Usage: ads1118_stats_benchmark [samples per test]
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118Stats.h"
+#include "HostBenchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static volatile float sink;            //Keeps the compiler from removing the results
+static uint16_t codes[4096];           //Codes added, repeated (noise around a DC value)
+
+/**
+ * Measuring add() and snapshot() with a window configuration and printing a JSON object
+ */
+static void runTest(const char *name, uint32_t windowSize, uint8_t windowMode, uint32_t samples, bool last) {
+    ADS1118Stats stats(windowSize, windowMode);
+    ADS1118Summary summary;
+    uint64_t start = cpuNs();
+    for (uint32_t i = 0; i < samples; i++)
+        stats.add(codes[i & 4095]);
+    uint64_t addNs = cpuNs() - start;
+    const uint32_t SNAPSHOTS = 100000;
+    start = cpuNs();
+    for (uint32_t i = 0; i < SNAPSHOTS; i++) {
+        stats.snapshot(summary);
+        sink = summary.variance;
+    }
+    uint64_t snapshotNs = cpuNs() - start;
+    printf("    {\"window\": \"%s\", \"window_size\": %u, \"samples\": %u, \"add_ns_per_sample\": %.3f, \"snapshot_ns\": %.3f, \"bytes_per_channel\": %u}%s\n",
+           name, windowSize, samples, (double)addNs/samples, (double)snapshotNs/SNAPSHOTS, (unsigned)sizeof(ADS1118Stats), last ? "" : ",");
+}
+
+int main(int argc, char **argv) {
+    uint32_t samples = argc > 1 ? strtoul(argv[1], 0, 10) : 100000000;
+    if (samples == 0) samples = 1;
+    uint32_t state = 1;
+    for (uint32_t i = 0; i < 4096; i++) {
+        state = state*1103515245 + 12345;
+        codes[i] = (uint16_t)(int16_t)(12000 + (int32_t)((state >> 16) % 201) - 100);
+    }
+    printf("{\n  \"class\": \"ADS1118Stats\",\n  \"results\": [\n");
+    runTest("none", 0, ADS1118Stats::TUMBLING, samples, false);
+    runTest("tumbling", 860, ADS1118Stats::TUMBLING, samples, false);
+    runTest("sliding", 860, ADS1118Stats::SLIDING, samples, true);
+    printf("  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef HostBenchmark_h
+#define HostBenchmark_h
+
+/**
+ * Helpers used by the host benchmarks. Tables of the chip (data rates, full scale
+ * ranges) are read with the ADS1118Noise accessors.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * Thread CPU time
+ * @return The CPU time used by this thread in ns
+ */
+static inline uint64_t cpuNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t)now.tv_sec*1000000000ULL + now.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef Arduino_h
+#define Arduino_h
+
+/**
+ * Minimal Arduino core for the host build (tests and benchmarks).
+ * The pins, delays and micros() are connected to a SimulatedADS1118 with hostAttach():
+ * delays advance its virtual time instead of sleeping.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void delayMicroseconds(unsigned int us);
+void delay(unsigned long ms);
+unsigned long micros();
+unsigned long millis();
+
+///String class of the Arduino core (only what the library uses)
+class String : public std::string {
+    public:
+        String() {}
+        String(const char *text) : std::string(text) {}
+        String(const std::string &text) : std::string(text) {}
+        String &operator=(const char *text) { assign(text); return *this; }
+};
+
+///Serial port writing to stdout
+class HardwareSerial {
+    public:
+        void begin(unsigned long) {}
+        void print(const char *text) { fputs(text, stdout); }
+        void print(const String &text) { fputs(text.c_str(), stdout); }
+        void println(const char *text) { puts(text); }
+        void println(const String &text) { puts(text.c_str()); }
+        void println() { puts(""); }
+};
+
+extern HardwareSerial Serial;
+
+#endif
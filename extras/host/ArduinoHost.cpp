@@ -0,0 +1,63 @@
+/**
+*  Minimal Arduino core and SPI library for the host build, backed by a SimulatedADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "SimulatedADS1118.h"
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+static SimulatedADS1118 *device = 0;   ///< Simulated chip connected to the pins and the SPI port
+static uint8_t chipSelect = 0xFF;       ///< Pin used as CS
+static uint64_t idleTime = 0;           ///< Virtual time in ns when no chip is connected
+
+void hostAttach(SimulatedADS1118 *simulated, uint8_t csPin) {
+    device = simulated;
+    chipSelect = csPin;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (!device || pin!=chipSelect) return;
+    if (value==LOW) device->select();
+    else device->deselect();
+}
+
+int digitalRead(uint8_t pin) {
+    (void)pin;
+    if (!device) return HIGH;
+    return device->dout() ? HIGH : LOW;    //Every input pin is DOUT/DRDY
+}
+
+void delayMicroseconds(unsigned int us) {
+    if (device) device->advance(us*1000ULL);
+    else idleTime += us*1000ULL;
+}
+
+void delay(unsigned long ms) {
+    if (device) device->advance(ms*1000000ULL);
+    else idleTime += ms*1000000ULL;
+}
+
+unsigned long micros() {
+    return (device ? device->now() : idleTime)/1000;
+}
+
+unsigned long millis() {
+    return (device ? device->now() : idleTime)/1000000;
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+    if (!device) return 0xFF;
+    return device->transfer(data, clock);
+}
@@ -0,0 +1,189 @@
+/**
+*  Mock of the Linux spidev driver for the host build of the Arduino Library for Texas Instruments ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "MockSpidev.h"
+#include <errno.h>
+
+MockSpidev *MockSpidev::active = 0;
+
+/**
+ * Constructor of the class: the mock becomes the one used by ioctl()
+ * @param chip The simulated chip connected to the bus
+ */
+MockSpidev::MockSpidev(SimulatedADS1118 &chip) : chip(chip) {
+    ioctls = 0;
+    messages = 0;
+    transferCount = 0;
+    mode = 0;
+    bitsPerWord = 0;
+    speed = 0;
+    selected = false;
+    messageNs = 0;
+    active = this;
+}
+
+/**
+ * Destructor of the class
+ */
+MockSpidev::~MockSpidev() {
+    if (active==this) active = 0;
+}
+
+/**
+ * ioctl() replacement: decoding the spidev requests
+ * @param fd The file descriptor (not used)
+ * @param request The ioctl request
+ * @param arg The ioctl argument
+ * @return Like the kernel: 0 for the settings, the bytes transferred for a message, -1 on error (errno set)
+ */
+int MockSpidev::ioctl(int fd, unsigned long request, void *arg) {
+    (void)fd;
+    MockSpidev *mock = active;
+    if (!mock || !arg) {
+        errno = EINVAL;
+        return -1;
+    }
+    mock->ioctls++;
+    if (request==SPI_IOC_WR_MODE) {
+        mock->mode = *(uint8_t *)arg;
+        return 0;
+    }
+    if (request==SPI_IOC_WR_BITS_PER_WORD) {
+        mock->bitsPerWord = *(uint8_t *)arg;
+        return 0;
+    }
+    if (request==SPI_IOC_WR_MAX_SPEED_HZ) {
+        mock->speed = *(uint32_t *)arg;
+        return 0;
+    }
+    if (_IOC_TYPE(request)==SPI_IOC_MAGIC && _IOC_NR(request)==0 && _IOC_DIR(request)==_IOC_WRITE) {
+        uint32_t size = _IOC_SIZE(request);
+        if (size==0 || size%sizeof(struct spi_ioc_transfer)!=0) {
+            errno = EINVAL;
+            return -1;
+        }
+        return mock->message((const struct spi_ioc_transfer *)arg, size/sizeof(struct spi_ioc_transfer));
+    }
+    errno = ENOTTY;
+    return -1;
+}
+
+/**
+ * Running an SPI_IOC_MESSAGE: CS is selected for the first transfer, each transfer clocks its
+ * bytes, waits delay_usecs and, with cs_change, deselects CS before the next transfer. cs_change
+ * in the last transfer leaves CS selected after the message.
+ * @param transfers The transfers of the message
+ * @param count Number of transfers
+ * @return The number of bytes transferred
+ */
+int MockSpidev::message(const struct spi_ioc_transfer *transfers, uint32_t count) {
+    uint64_t start = chip.now();
+    int bytes = 0;
+    messages++;
+    transferCount += count;
+    last.assign(transfers, transfers+count);
+    for (uint32_t i=0; i<count; i++) {
+        const struct spi_ioc_transfer &transfer = transfers[i];
+        uint32_t sclk = transfer.speed_hz ? transfer.speed_hz : speed;
+        if (transfer.len>0 && sclk==0) {
+            errno = EINVAL;
+            return -1;
+        }
+        if (!selected) {
+            chip.select();
+            selected = true;
+        }
+        const uint8_t *tx = (const uint8_t *)(uintptr_t)transfer.tx_buf;
+        uint8_t *rx = (uint8_t *)(uintptr_t)transfer.rx_buf;
+        for (uint32_t j=0; j<transfer.len; j++) {
+            uint8_t miso = chip.transfer(tx ? tx[j] : 0, sclk);
+            if (rx) rx[j] = miso;
+        }
+        bytes += transfer.len;
+        chip.advance(transfer.delay_usecs*1000ULL);
+        bool lastTransfer = (i==count-1);
+        if (transfer.cs_change ? !lastTransfer : lastTransfer) {
+            chip.deselect();
+            selected = false;
+        }
+    }
+    messageNs = chip.now() - start;
+    return bytes;
+}
+
+/**
+ * Number of ioctl() calls
+ * @return The number of calls (settings and messages)
+ */
+uint32_t MockSpidev::getIoctls() {
+    return ioctls;
+}
+
+/**
+ * Number of SPI_IOC_MESSAGE calls
+ * @return The number of messages
+ */
+uint32_t MockSpidev::getMessages() {
+    return messages;
+}
+
+/**
+ * Number of transfers in every message
+ * @return The number of transfers
+ */
+uint32_t MockSpidev::getTransfers() {
+    return transferCount;
+}
+
+/**
+ * SPI mode set with SPI_IOC_WR_MODE
+ * @return The SPI mode
+ */
+uint8_t MockSpidev::getMode() {
+    return mode;
+}
+
+/**
+ * Word size set with SPI_IOC_WR_BITS_PER_WORD
+ * @return The bits per word
+ */
+uint8_t MockSpidev::getBitsPerWord() {
+    return bitsPerWord;
+}
+
+/**
+ * SCLK set with SPI_IOC_WR_MAX_SPEED_HZ
+ * @return The SCLK frequency in Hz
+ */
+uint32_t MockSpidev::getSpeed() {
+    return speed;
+}
+
+/**
+ * True if CS was left selected by the last message (cs_change in its last transfer)
+ * @return The CS state
+ */
+bool MockSpidev::csSelected() {
+    return selected;
+}
+
+/**
+ * Virtual duration of the last message
+ * @return The duration in ns
+ */
+uint64_t MockSpidev::getMessageNs() {
+    return messageNs;
+}
+
+/**
+ * Transfers of the last message (their buffers point to memory of the caller)
+ * @return The transfers
+ */
+const std::vector<struct spi_ioc_transfer> &MockSpidev::lastMessage() {
+    return last;
+}
@@ -0,0 +1,48 @@
+#ifndef MockSpidev_h
+#define MockSpidev_h
+
+#include <stdint.h>
+#include <vector>
+#include <linux/spi/spidev.h>
+#include "SimulatedADS1118.h"
+
+/**
+ * Mock of the Linux spidev driver used by the host build to test ADS1118Spidev.
+ * ioctl() (given to ADS1118Spidev as its IoctlFunction) decodes the requests like the
+ * kernel does: the SPI_IOC_WR_* settings are stored and every spi_ioc_transfer of an
+ * SPI_IOC_MESSAGE is clocked through a SimulatedADS1118, then delay_usecs advances its
+ * virtual time and cs_change toggles CS (or keeps it selected after the last transfer).
+ * Every call and transfer is counted and the transfers of the last message are kept.
+ * @author Alvaro Salazar <alvaro@denkitronik.com>
+ */
+class MockSpidev {
+    public:
+        MockSpidev(SimulatedADS1118 &chip);	///< Constructor: the mock becomes the one used by ioctl()
+        ~MockSpidev();						///< Destructor
+        static int ioctl(int fd, unsigned long request, void *arg);	///< ioctl() replacement (ADS1118Spidev::IoctlFunction)
+        uint32_t getIoctls();				///< Number of ioctl() calls
+        uint32_t getMessages();				///< Number of SPI_IOC_MESSAGE calls
+        uint32_t getTransfers();			///< Number of transfers in every message
+        uint8_t getMode();					///< SPI mode set with SPI_IOC_WR_MODE
+        uint8_t getBitsPerWord();			///< Word size set with SPI_IOC_WR_BITS_PER_WORD
+        uint32_t getSpeed();				///< SCLK set with SPI_IOC_WR_MAX_SPEED_HZ
+        bool csSelected();					///< True if CS was left selected by the last message
+        uint64_t getMessageNs();			///< Virtual duration of the last message in ns
+        const std::vector<struct spi_ioc_transfer> &lastMessage();	///< Transfers of the last message
+
+    private:
+        int message(const struct spi_ioc_transfer *transfers, uint32_t count);
+        static MockSpidev *active;			///< Mock used by ioctl()
+        SimulatedADS1118 &chip;				///< Simulated chip on the bus
+        uint32_t ioctls;					///< ioctl() calls
+        uint32_t messages;					///< SPI_IOC_MESSAGE calls
+        uint32_t transferCount;				///< Transfers in every message
+        uint8_t mode;						///< SPI mode
+        uint8_t bitsPerWord;				///< Word size
+        uint32_t speed;						///< Default SCLK in Hz
+        bool selected;						///< CS level kept between messages
+        uint64_t messageNs;					///< Virtual duration of the last message
+        std::vector<struct spi_ioc_transfer> last;	///< Transfers of the last message
+};
+
+#endif
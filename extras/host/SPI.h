@@ -0,0 +1,35 @@
+#ifndef SPI_h
+#define SPI_h
+
+/**
+ * Minimal SPI library for the host build (ESP32 API). The bytes are exchanged
+ * with the SimulatedADS1118 connected by hostAttach().
+ */
+
+#include <stdint.h>
+
+#define MSBFIRST 1
+#define SPI_MODE1 1
+
+///SPI settings: only the clock is used (to compute the bus time)
+class SPISettings {
+    public:
+        SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : clock(clock) { (void)bitOrder; (void)dataMode; }
+        uint32_t clock;
+};
+
+///SPI port connected to the simulated chip
+class SPIClass {
+    public:
+        void begin() {}
+        void begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) { (void)sck; (void)miso; (void)mosi; (void)ss; }
+        void beginTransaction(SPISettings settings) { clock = settings.clock; }
+        void endTransaction() {}
+        uint8_t transfer(uint8_t data);
+    private:
+        uint32_t clock = 2000000;
+};
+
+extern SPIClass SPI;
+
+#endif
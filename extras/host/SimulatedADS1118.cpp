@@ -0,0 +1,272 @@
+/**
+*  Simulated ADS1118 for the host build of the Arduino Library for Texas Instruments ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "SimulatedADS1118.h"
+#include "ADS1118Config.h"
+#include "ADS1118Noise.h"
+#include <math.h>
+
+/**
+ * Constructor of the class: power-up state
+ */
+SimulatedADS1118::SimulatedADS1118() {
+    for (uint8_t i=0; i<8; i++) inputs[i] = 0;
+    temperature = 25;
+    config = 0x058B;
+    conversionConfig = config;
+    output = 0;
+    converting = false;
+    dataReady = false;
+    conversionEnd = 0;
+    selected = false;
+    position = 0;
+    written[0] = written[1] = 0;
+    data = 0;
+    echoFrom = echoTo = 0;
+    echoMask = 0;
+    writeFrom = writeTo = 0;
+    writeMask = 0;
+    time = 0;
+    busNs = 0;
+    frames = 0;
+    conversions = 0;
+}
+
+/**
+ * Setting the voltage seen by a MUX code
+ * @param mux The MUX code (DIFF_0_1 ... AIN_3)
+ * @param milliVolts The input voltage in mV
+ */
+void SimulatedADS1118::setInput(uint8_t mux, float milliVolts) {
+    inputs[mux & 0b111] = milliVolts;
+}
+
+/**
+ * Setting the temperature of the internal sensor
+ * @param celsius The temperature in degrees celsius
+ */
+void SimulatedADS1118::setTemperature(float celsius) {
+    temperature = celsius;
+}
+
+/**
+ * Flipping bits of the config echoed by the next frames (glitches on DOUT)
+ * @param frames Number of frames to corrupt
+ * @param mask Bits to flip in the echo
+ * @param after Number of frames left intact before the first corrupted one
+ */
+void SimulatedADS1118::corruptEchoes(uint32_t frames, uint16_t mask, uint32_t after) {
+    echoFrom = this->frames + after;
+    echoTo = echoFrom + frames;
+    echoMask = mask;
+}
+
+/**
+ * Flipping bits of the config received in the next frames (glitches on DIN): the chip
+ * applies the corrupted config and echoes it
+ * @param frames Number of frames to corrupt
+ * @param mask Bits to flip in the config received
+ * @param after Number of frames left intact before the first corrupted one
+ */
+void SimulatedADS1118::corruptWrites(uint32_t frames, uint16_t mask, uint32_t after) {
+    writeFrom = this->frames + after;
+    writeTo = writeFrom + frames;
+    writeMask = mask;
+}
+
+/**
+ * CS low: a frame starts
+ */
+void SimulatedADS1118::select() {
+    selected = true;
+    position = 0;
+}
+
+/**
+ * CS high: the frame ends
+ */
+void SimulatedADS1118::deselect() {
+    if (selected && position>0) frames++;
+    selected = false;
+}
+
+/**
+ * Exchanging one byte. The bytes sent while CS is high are ignored
+ * @param mosi The byte written to DIN
+ * @param sclk The SCLK frequency in Hz
+ * @return The byte read from DOUT
+ */
+uint8_t SimulatedADS1118::transfer(uint8_t mosi, uint32_t sclk) {
+    uint64_t ns = 8000000000ULL/sclk;
+    time += ns;
+    busNs += ns;
+    if (!selected) return 0xFF;
+    update();
+    uint8_t miso = 0xFF;
+    uint16_t echoFlip = (frames>=echoFrom && frames<echoTo) ? echoMask : 0;
+    switch (position & 0b11) {
+        case 0:
+            data = output;  //The data of the frame is latched when the frame starts
+            dataReady = false;
+            miso = data >> 8;
+            break;
+        case 1:
+            miso = data & 0xFF;
+            break;
+        case 2:
+            miso = (config ^ echoFlip) >> 8;
+            break;
+        case 3:
+            miso = (config ^ echoFlip) & 0xFF;
+            break;
+    }
+    if (position<2) written[position] = mosi;
+    position++;
+    if (position==2) {     //16 bits received: writing the config register
+        union Config received;
+        received.byte.msb = written[0];
+        received.byte.lsb = written[1];
+        if (frames>=writeFrom && frames<writeTo) received.word ^= writeMask;
+        if (received.bits.noOperation==0b01) {
+            uint16_t previous = config;
+            config = received.word;
+            if (received.bits.operatingMode==1) {
+                if (received.bits.singleStart==1 && !converting) startConversion(time);
+            } else if (!converting || ((previous ^ config) & 0x7FFE)) {
+                startConversion(time);
+            }
+        }
+    }
+    return miso;
+}
+
+/**
+ * Level of DOUT/DRDY
+ * @return False (low) when CS is low and a conversion not read yet is ready
+ */
+bool SimulatedADS1118::dout() {
+    update();
+    return !(selected && dataReady);
+}
+
+/**
+ * Advancing the virtual time
+ * @param ns Time in ns
+ */
+void SimulatedADS1118::advance(uint64_t ns) {
+    time += ns;
+}
+
+/**
+ * Virtual time
+ * @return The time in ns since the construction
+ */
+uint64_t SimulatedADS1118::now() {
+    return time;
+}
+
+/**
+ * Content of the config register
+ * @return The config register
+ */
+uint16_t SimulatedADS1118::getConfig() {
+    return config;
+}
+
+/**
+ * Code that a conversion of an input gives
+ * @param mux The MUX code
+ * @param pga The PGA code
+ * @return The code in binary twos complement format
+ */
+uint16_t SimulatedADS1118::codeFor(uint8_t mux, uint8_t pga) {
+    float code = roundf(inputs[mux & 0b111]/ADS1118Noise::fullScaleMilliVolts(pga & 0b111)*32768);
+    if (code>32767) code = 32767;
+    if (code<-32768) code = -32768;
+    return (uint16_t)(int16_t)code;
+}
+
+/**
+ * Frames with at least one byte
+ * @return The number of frames
+ */
+uint32_t SimulatedADS1118::getFrames() {
+    return frames;
+}
+
+/**
+ * Conversions completed
+ * @return The number of conversions
+ */
+uint32_t SimulatedADS1118::getConversions() {
+    return conversions;
+}
+
+/**
+ * Time spent clocking bytes
+ * @return The bus time in ns
+ */
+uint64_t SimulatedADS1118::getBusNs() {
+    return busNs;
+}
+
+/**
+ * Completing the conversions that ended before the current time
+ */
+void SimulatedADS1118::update() {
+    while (converting && time>=conversionEnd) {
+        output = convert(conversionConfig);
+        dataReady = true;
+        conversions++;
+        union Config current;
+        current.word = config;
+        if (current.bits.operatingMode==0) {   //Continuous mode: the next conversion starts now
+            uint64_t end = conversionEnd;
+            conversionConfig = config;
+            conversionEnd = end + periodNs(config);
+        } else {
+            converting = false;
+        }
+    }
+}
+
+/**
+ * Starting a conversion with the config register
+ * @param at Start time in ns
+ */
+void SimulatedADS1118::startConversion(uint64_t at) {
+    converting = true;
+    conversionConfig = config;
+    conversionEnd = at + periodNs(config);
+}
+
+/**
+ * Result of a conversion
+ * @param config Config of the conversion
+ * @return The code in binary twos complement format
+ */
+uint16_t SimulatedADS1118::convert(uint16_t config) {
+    union Config settings;
+    settings.word = config;
+    if (settings.bits.sensorMode==1) {     //14-bit left justified, 0.03125 degrees per LSB
+        int16_t code = (int16_t)roundf(temperature/0.03125);
+        return (uint16_t)((uint16_t)code << 2);
+    }
+    return codeFor(settings.bits.mux, settings.bits.pga);
+}
+
+/**
+ * Conversion time
+ * @param config Config of the conversion
+ * @return The conversion time in ns
+ */
+uint64_t SimulatedADS1118::periodNs(uint16_t config) {
+    union Config settings;
+    settings.word = config;
+    return 1000000000ULL/ADS1118Noise::samplesPerSecond(settings.bits.rate);
+}
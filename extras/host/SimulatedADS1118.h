@@ -0,0 +1,68 @@
+#ifndef SimulatedADS1118_h
+#define SimulatedADS1118_h
+
+#include <stdint.h>
+
+/**
+ * Simulated ADS1118 used by the host build (tests and benchmarks).
+ * It is driven byte by byte (select(), transfer(), deselect()) like the real SPI
+ * interface and keeps its own virtual time: conversions take exactly 1/SPS, the
+ * bus takes 8 bits per byte at the SCLK used and delays only advance the clock.
+ * Frames follow the datasheet: the first 16 bits return the last conversion and
+ * write the config (if NOP is 01), the next 16 bits echo the config register.
+ * @author Alvaro Salazar <alvaro@denkitronik.com>
+ */
+class SimulatedADS1118 {
+    public:
+        SimulatedADS1118();							///< Constructor: power-up state (config 0x058B)
+        void setInput(uint8_t mux, float milliVolts);	///< Setting the voltage seen by a MUX code
+        void setTemperature(float celsius);			///< Setting the temperature of the internal sensor
+        void corruptEchoes(uint32_t frames, uint16_t mask=0x1000, uint32_t after=0);	///< Flipping bits of the echo of the next frames
+        void corruptWrites(uint32_t frames, uint16_t mask=0x1000, uint32_t after=0);	///< Flipping bits of the config received in the next frames
+        void select();								///< CS low: a frame starts
+        void deselect();							///< CS high: the frame ends
+        uint8_t transfer(uint8_t mosi, uint32_t sclk);	///< Exchanging one byte at the SCLK frequency given
+        bool dout();								///< Level of DOUT/DRDY (low when CS is low and a new conversion is ready)
+        void advance(uint64_t ns);					///< Advancing the virtual time
+        uint64_t now();								///< Virtual time in ns
+        uint16_t getConfig();						///< Content of the config register
+        uint16_t codeFor(uint8_t mux, uint8_t pga);	///< Code that a conversion of an input gives with a PGA code
+        uint32_t getFrames();						///< Frames with at least one byte
+        uint32_t getConversions();					///< Conversions completed
+        uint64_t getBusNs();						///< Time spent clocking bytes in ns
+
+    private:
+        void update();
+        void startConversion(uint64_t at);
+        uint16_t convert(uint16_t config);
+        static uint64_t periodNs(uint16_t config);
+        float inputs[8];			///< Voltage seen by each MUX code in mV
+        float temperature;			///< Internal sensor temperature in degrees celsius
+        uint16_t config;			///< Config register
+        uint16_t conversionConfig;	///< Config of the conversion in progress
+        uint16_t output;			///< Last conversion
+        bool converting;			///< True while a conversion is in progress
+        bool dataReady;				///< True when "output" holds a conversion not read yet
+        uint64_t conversionEnd;		///< End of the conversion in progress
+        bool selected;				///< CS level
+        uint8_t position;			///< Bytes exchanged in the current frame
+        uint8_t written[2];			///< Config bytes received in the current frame
+        uint16_t data;				///< Data sent in the current frame
+        uint32_t echoFrom, echoTo;	///< Frames (numbered by "frames") whose echo is corrupted
+        uint16_t echoMask;			///< Bits flipped in a corrupted echo
+        uint32_t writeFrom, writeTo;	///< Frames whose received config is corrupted
+        uint16_t writeMask;			///< Bits flipped in a corrupted config
+        uint64_t time;				///< Virtual time in ns
+        uint64_t busNs;				///< Time spent clocking bytes in ns
+        uint32_t frames;			///< Frames with at least one byte
+        uint32_t conversions;		///< Conversions completed
+};
+
+/**
+ * Connecting the Arduino shim (digitalWrite, digitalRead, delays, micros and SPI) to a simulated chip
+ * @param device The simulated ADS1118 (0 to disconnect it)
+ * @param csPin The pin used as CS by the ADS1118 object
+ */
+void hostAttach(SimulatedADS1118 *device, uint8_t csPin);
+
+#endif
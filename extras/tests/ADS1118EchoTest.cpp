@@ -0,0 +1,86 @@
+/**
+*  Host tests of the config echo checking of ADS1118 (corrupted frames on a simulated bus)
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118.h"
+#include "SimulatedADS1118.h"
+#include "HostTest.h"
+
+#define CS 5
+
+/**
+ * Reading AIN_0 and checking the value, the validity and the frames used
+ */
+static void checkRead(ADS1118 &ads1118, SimulatedADS1118 &chip, bool valid, uint32_t frames, uint32_t errors) {
+    uint32_t startFrames = ads1118.getFrames();
+    uint32_t startErrors = ads1118.getFrameErrors();
+    uint16_t value = ads1118.getADCValue(ads1118.AIN_0);
+    CHECK(ads1118.lastSampleValid() == valid);
+    if (valid) CHECK(value == chip.codeFor(ads1118.AIN_0, ads1118.configRegister.bits.pga));
+    CHECK(ads1118.getFrames() - startFrames == frames);
+    CHECK(ads1118.getFrameErrors() - startErrors == errors);
+}
+
+int main() {
+    SimulatedADS1118 chip;
+    hostAttach(&chip, CS);
+    ADS1118 ads1118(CS);
+    ads1118.begin();
+    ads1118.setSamplingRate(ads1118.RATE_860SPS);
+    ads1118.setFullScaleRange(ads1118.FSR_2048);
+    chip.setInput(ads1118.AIN_0, 1000);
+    chip.setInput(ads1118.AIN_1, -500);
+    chip.setTemperature(21.5);
+
+    //Clean bus: two frames, valid
+    checkRead(ads1118, chip, true, 2, 0);
+    CHECK(chip.getFrames() == 2);
+
+    //Echo glitch in the first frame: the second frame started the right conversion, one more frame
+    ads1118.setMaxRetries(1);
+    chip.corruptEchoes(1);
+    checkRead(ads1118, chip, true, 3, 1);
+
+    //Echo glitch in the second frame: the two frames are sent again
+    chip.corruptEchoes(1, 0x1000, 1);
+    checkRead(ads1118, chip, true, 4, 1);
+
+    //Config corrupted on DIN in the first frame: the chip converts AIN_1, the echo shows it
+    chip.corruptWrites(1, 0x1000);
+    checkRead(ads1118, chip, true, 3, 1);
+
+    //Config corrupted on DIN in the second frame: the data read after it would be AIN_1
+    chip.corruptWrites(1, 0x1000, 1);
+    checkRead(ads1118, chip, true, 4, 1);
+
+    //No retries allowed: the glitch is reported
+    ads1118.setMaxRetries(0);
+    chip.corruptEchoes(1, 0x1000, 1);
+    checkRead(ads1118, chip, false, 2, 1);
+    checkRead(ads1118, chip, true, 2, 0);
+
+    //Persistent corruption: two retries of two frames each, then the sample is invalid
+    ads1118.setMaxRetries(2);
+    chip.corruptEchoes(100);
+    checkRead(ads1118, chip, false, 6, 6);
+    chip.corruptEchoes(0);
+    checkRead(ads1118, chip, true, 2, 0);
+
+    //The temperature is checked the same way
+    chip.corruptEchoes(1, 0x0010, 1);
+    uint32_t frames = ads1118.getFrames();
+    CHECK_NEAR(ads1118.getTemperature(), 21.5, 1e-9);
+    CHECK(ads1118.lastSampleValid());
+    CHECK(ads1118.getFrames() - frames == 4);
+
+    //Slow rate: the waits cover the conversion time as well
+    ads1118.setSamplingRate(ads1118.RATE_8SPS);
+    chip.corruptWrites(1, 0x1000, 1);
+    checkRead(ads1118, chip, true, 4, 1);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+/**
+*  Host tests of ADS1118Noise: datasheet tables, planner choices and the timing it predicts
+*  compared with the ADS1118 class running on the simulated chip
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118.h"
+#include "SimulatedADS1118.h"
+#include "HostTest.h"
+#include <math.h>
+
+#define CS 5
+
+/**
+ * Checking that no configuration meeting the requirements gives more readings per second than the plan
+ */
+static void checkOptimal(float resolution, float range, uint8_t channels, float latencyMs) {
+    ADS1118Plan plan = ADS1118Noise::plan(resolution, range, channels, latencyMs);
+    bool anyFeasible = false;
+    for (uint8_t f = 0; f < ADS1118Noise::FSR_COUNT; f++) {
+        uint8_t fsr = ADS1118Noise::fsrCode(f);
+        float lsb = ADS1118Noise::fullScaleMilliVolts(fsr)*1000.0/32768;
+        if (ADS1118Noise::fullScaleMilliVolts(fsr) < range || resolution < lsb) continue;
+        for (uint8_t rate = 0; rate < 8; rate++) {
+            float noise = ADS1118Noise::noisePeakToPeak(rate, fsr);
+            uint32_t k = 1;
+            while (noise/sqrt(k) > resolution*1.0001 && k <= ADS1118Noise::MAX_OVERSAMPLING) k++;
+            if (k > ADS1118Noise::MAX_OVERSAMPLING) continue;
+            float latency = channels*k*ADS1118Noise::conversionCostMs(rate);
+            if (latencyMs > 0 && latency > latencyMs) continue;
+            anyFeasible = true;
+            CHECK(plan.feasible);
+            CHECK(1000.0/latency <= plan.readingsPerSecond*1.0001);
+        }
+    }
+    CHECK(plan.feasible == anyFeasible);
+    if (plan.feasible) {
+        CHECK(plan.noiseMicroVolts <= resolution*1.0001);
+        CHECK(ADS1118Noise::fullScaleMilliVolts(plan.fsr) >= range);
+        CHECK_NEAR(plan.latencyMs, channels*plan.oversampling*ADS1118Noise::conversionCostMs(plan.rate), 1e-3);
+        CHECK_NEAR(plan.readingsPerSecond, 1000.0/plan.latencyMs, 1e-3);
+    }
+}
+
+/**
+ * Running a plan with the ADS1118 class on the simulated chip and comparing the time of one
+ * averaged reading of every channel with plan.latencyMs
+ */
+static void checkTiming(float resolution, float range, uint8_t channels) {
+    ADS1118Plan plan = ADS1118Noise::plan(resolution, range, channels);
+    CHECK(plan.feasible);
+    if (!plan.feasible) return;
+    SimulatedADS1118 chip;
+    hostAttach(&chip, CS);
+    ADS1118 ads1118(CS);
+    ads1118.begin();
+    ads1118.applyPlan(plan);
+    uint64_t start = chip.now();
+    for (uint8_t channel = 0; channel < channels; channel++)
+        for (uint16_t i = 0; i < plan.oversampling; i++)
+            ads1118.getMilliVolts(ads1118.AIN_0 + (channel & 3));
+    double elapsedMs = (chip.now() - start)/1e6;
+    CHECK_NEAR(elapsedMs, plan.latencyMs, plan.latencyMs*1e-4);
+    CHECK(chip.getFrames() == 2u*channels*plan.oversampling);
+    hostAttach(0, CS);
+}
+
+int main() {
+    //Tables
+    CHECK(ADS1118Noise::samplesPerSecond(0) == 8 && ADS1118Noise::samplesPerSecond(7) == 860);
+    CHECK(ADS1118Noise::fullScaleMilliVolts(0b000) == 6144 && ADS1118Noise::fullScaleMilliVolts(0b111) == 256);
+    CHECK(ADS1118Noise::fullScaleMilliVolts(0b101) == 256 && ADS1118Noise::fullScaleMilliVolts(0b110) == 256);
+    CHECK(ADS1118Noise::fsrIndex(0b100) == 4 && ADS1118Noise::fsrIndex(0b111) == 5);
+    for (uint8_t f = 0; f < ADS1118Noise::FSR_COUNT; f++) CHECK(ADS1118Noise::fsrIndex(ADS1118Noise::fsrCode(f)) == f);
+    CHECK(ADS1118Noise::fsrCode(5) == 0b111 && ADS1118Noise::fsrCode(9) == 0b111);
+    CHECK_NEAR(ADS1118Noise::noisePeakToPeak(5, 0b100), 16.06, 1e-4);
+    CHECK_NEAR(ADS1118Noise::noisePeakToPeak(5, 0b111), 18.53, 1e-4);
+    CHECK_NEAR(ADS1118Noise::noisePeakToPeak(7, 0b000), 430.06, 1e-3);
+    CHECK_NEAR(ADS1118Noise::noisePeakToPeak(4, 0b111), 12.35, 1e-4);
+    CHECK_NEAR(ADS1118Noise::noiseFreeBits(7, 0b111), 13.80, 1e-4);
+    CHECK_NEAR(ADS1118Noise::noiseFreeBits(6, 0b001), 15.13, 1e-4);
+    CHECK_NEAR(ADS1118Noise::conversionCostMs(7), 4.032, 1e-4);
+    CHECK_NEAR(ADS1118Noise::conversionCostMs(0), 250.032, 1e-3);
+    for (uint8_t rate = 0; rate < 8; rate++) {
+        CHECK(ADS1118Noise::conversionTimeMs(rate) >= 1000.0/ADS1118Noise::samplesPerSecond(rate));
+        CHECK(ADS1118Noise::conversionTimeMs(rate) < 1000.0/ADS1118Noise::samplesPerSecond(rate) + 1);
+        for (uint8_t f = 0; f < ADS1118Noise::FSR_COUNT; f++) {
+            uint8_t fsr = ADS1118Noise::fsrCode(f);
+            float lsb = ADS1118Noise::fullScaleMilliVolts(fsr)*1000.0/32768;
+            CHECK_NEAR(ADS1118Noise::noiseRms(rate, fsr), lsb, 0.01);    //RMS noise is one LSB
+            CHECK(ADS1118Noise::enob(rate, fsr) == 16);
+            CHECK(ADS1118Noise::noisePeakToPeak(rate, fsr) >= lsb - 0.01);
+            //Noise-free bits are log2(full scale / peak-to-peak noise), up to 16
+            double bits = log2(2*ADS1118Noise::fullScaleMilliVolts(fsr)*1000.0/ADS1118Noise::noisePeakToPeak(rate, fsr));
+            CHECK_NEAR(ADS1118Noise::noiseFreeBits(rate, fsr), bits > 16 ? 16 : bits, 0.02);
+        }
+    }
+
+    //The smallest FSR is not always the least noisy: ±0.512 V at 250 SPS beats ±0.256 V at 860 SPS x5
+    ADS1118Plan plan = ADS1118Noise::plan(16.1, 200, 1);
+    CHECK(plan.feasible);
+    CHECK(plan.rate == 5 && plan.fsr == 0b100 && plan.oversampling == 1);
+    CHECK_NEAR(plan.latencyMs, 8.032, 1e-3);
+
+    //Driver cost: 100μV, ±1.5 V, 2 channels, 100 ms -> 475 SPS without averaging, about 83 readings/s
+    plan = ADS1118Noise::plan(100, 1500, 2, 100);
+    CHECK(plan.feasible);
+    CHECK(plan.rate == 6 && plan.fsr == 0b010 && plan.oversampling == 1);
+    CHECK_NEAR(plan.readingsPerSecond, 82.89, 0.01);
+
+    //Infeasible requirements
+    CHECK(!ADS1118Noise::plan(100, 7000, 1).feasible);     //Out of range
+    CHECK(!ADS1118Noise::plan(5, 200, 1).feasible);        //Below one LSB of ±0.256 V
+    CHECK(!ADS1118Noise::plan(100, 200, 0).feasible);      //No channels
+    CHECK(!ADS1118Noise::plan(0, 200, 1).feasible);
+    CHECK(!ADS1118Noise::plan(100, 200, 4, 10).feasible);  //4 conversions need 16 ms at least
+
+    //The plan is the fastest configuration meeting the requirements
+    const float resolutions[] = {8, 10, 16.1, 20, 40, 100, 200, 500};
+    const float ranges[] = {100, 256, 300, 600, 1500, 3000, 5000};
+    const uint8_t channels[] = {1, 2, 4};
+    const float latencies[] = {0, 20, 100, 1000};
+    for (float resolution : resolutions)
+        for (float range : ranges)
+            for (uint8_t count : channels)
+                for (float latency : latencies)
+                    checkOptimal(resolution, range, count, latency);
+
+    //The predicted time is the time of the ADS1118 class
+    checkTiming(16.1, 200, 1);
+    checkTiming(100, 1500, 2);
+    checkTiming(10, 200, 3);
+    checkTiming(200, 5000, 4);
+
+    return TEST_RESULT();
+}
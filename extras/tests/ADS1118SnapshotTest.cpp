@@ -0,0 +1,166 @@
+/**
+*  Host tests of ADS1118Snapshot: one publisher and several readers (threads and processes)
+*  must never see a torn reading
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118Snapshot.h"
+#include "HostTest.h"
+#include <thread>
+#include <atomic>
+#include <type_traits>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+
+static_assert(!std::is_copy_constructible<ADS1118Snapshot>::value, "ADS1118Snapshot must not be copyable");
+static_assert(!std::is_copy_assignable<ADS1118Snapshot>::value, "ADS1118Snapshot must not be copyable");
+
+static const uint32_t PUBLISHED = 10000000;    ///< Readings published by the stress tests
+static const int READERS = 4;                   ///< Reader threads
+
+/**
+ * Publishing reading number n of a channel: every field is derived from n, so a torn
+ * reading (fields of two publications) is detected by the readers
+ */
+static void publishReading(ADS1118Snapshot &snapshot, uint8_t channel, uint32_t n) {
+    snapshot.publish(channel, (uint16_t)(n*7), (float)(n & 0xFFFFF), n*3);
+}
+
+/**
+ * Checking a reading against the sequence it claims to be
+ * @return False if the reading is torn
+ */
+static bool consistent(const ADS1118Reading &reading) {
+    uint32_t n = reading.sequence;
+    return reading.code==(uint16_t)(n*7) && reading.value==(float)(n & 0xFFFFF) && reading.timestamp==n*3;
+}
+
+/**
+ * Reading every channel until the publisher stops
+ * @return Number of torn or out of order readings
+ */
+static uint32_t readUntilDone(ADS1118Snapshot &snapshot, std::atomic<bool> &done, uint32_t &reads) {
+    uint32_t errors = 0;
+    uint32_t last[ADS1118Snapshot::CHANNELS] = {0};
+    reads = 0;
+    while (!done.load(std::memory_order_relaxed)) {
+        for (uint8_t channel=0; channel<ADS1118Snapshot::CHANNELS; channel++) {
+            ADS1118Reading reading;
+            if (!snapshot.read(channel, reading)) continue;
+            reads++;
+            if (!consistent(reading) || reading.sequence<last[channel]) errors++;
+            last[channel] = reading.sequence;
+        }
+    }
+    return errors;
+}
+
+/**
+ * Publishing PUBLISHED readings spread over the channels (most of them on channel 0 to
+ * make the readers meet the publisher)
+ */
+static void publishAll(ADS1118Snapshot &snapshot) {
+    uint32_t counts[ADS1118Snapshot::CHANNELS] = {0};
+    for (uint32_t i=0; i<PUBLISHED; i++) {
+        uint8_t channel = (i%4) ? 0 : (i/4)%ADS1118Snapshot::CHANNELS;
+        publishReading(snapshot, channel, ++counts[channel]);
+    }
+}
+
+int main() {
+    ADS1118Reading reading;
+
+    //Empty table and invalid channels
+    ADS1118Snapshot snapshot;
+    for (uint8_t channel=0; channel<ADS1118Snapshot::CHANNELS; channel++) CHECK(!snapshot.read(channel, reading));
+    CHECK(!snapshot.read(ADS1118Snapshot::CHANNELS, reading));
+    snapshot.publish(ADS1118Snapshot::CHANNELS, 1, 1, 1);
+    snapshot.publish(ADS1118Snapshot::TEMPERATURE, 0x0C80, 25.0f, 1234);
+    CHECK(snapshot.read(ADS1118Snapshot::TEMPERATURE, reading));
+    CHECK(reading.sequence==1 && reading.code==0x0C80 && reading.value==25.0f && reading.timestamp==1234);
+
+    //Threads: one publisher, several readers
+    ADS1118Snapshot shared;
+    std::atomic<bool> done(false);
+    uint32_t errors[READERS], reads[READERS];
+    std::thread readers[READERS];
+    for (int i=0; i<READERS; i++)
+        readers[i] = std::thread([&, i]() { errors[i] = readUntilDone(shared, done, reads[i]); });
+    publishAll(shared);
+    done = true;
+    for (int i=0; i<READERS; i++) {
+        readers[i].join();
+        CHECK(errors[i]==0);
+        CHECK(reads[i]>0);
+    }
+    uint32_t total = 0;
+    for (uint8_t channel=0; channel<ADS1118Snapshot::CHANNELS; channel++) {
+        CHECK(shared.read(channel, reading));
+        CHECK(consistent(reading));
+        total += reading.sequence;
+    }
+    CHECK(total==PUBLISHED);
+
+    //Processes: the table in POSIX shared memory, read by a child process
+    char name[64];
+    snprintf(name, sizeof(name), "/ads1118-test-%d", (int)getpid());
+    ADS1118Snapshot reader;
+    CHECK(!reader.openShared(name, false));    //Not created yet
+    ADS1118Snapshot publisher;
+    CHECK(publisher.openShared(name, true));
+    CHECK(!publisher.read(0, reading));         //A new table is empty
+    publisher.publish(0, 7, 1.0f, 3);           //Readers need something to start with
+    int ready[2];
+    CHECK(pipe(ready)==0);
+    pid_t child = fork();
+    if (child==0) {
+        ADS1118Snapshot childReader;
+        char go = 1;
+        if (!childReader.openShared(name, false)) _exit(2);
+        if (write(ready[1], &go, 1)!=1) _exit(2);
+        uint32_t last = 0, childErrors = 0;
+        while (true) {
+            if (!childReader.read(0, reading)) _exit(3);
+            if (!consistent(reading) || reading.sequence<last) childErrors++;
+            last = reading.sequence;
+            if (childReader.read(1, reading) && reading.sequence==1) break;   //Publisher finished
+        }
+        if (!childReader.read(0, reading) || !consistent(reading)) childErrors++;
+        last = reading.sequence;
+        _exit(childErrors==0 && last==PUBLISHED ? 0 : 1);
+    }
+    char go;
+    CHECK(read(ready[0], &go, 1)==1);
+    for (uint32_t n=2; n<=PUBLISHED; n++) publishReading(publisher, 0, n);
+    publisher.publish(1, 0, 0, 0);
+    int status = -1;
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status)==0);
+
+    //Another mapping sees the same table, read-only: publish() on a reader writes nothing
+    CHECK(reader.openShared(name, false));
+    CHECK(reader.read(0, reading) && reading.sequence==PUBLISHED);
+    reader.publish(0, 1, 1.0f, 1);
+    CHECK(reader.read(0, reading) && reading.sequence==PUBLISHED && consistent(reading));
+    //closeShared() goes back to the local table
+    reader.closeShared();
+    CHECK(!reader.read(0, reading));
+    CHECK(ADS1118Snapshot::removeShared(name));
+    CHECK(!ADS1118Snapshot::removeShared(name));
+
+    //Object created but not sized yet by the publisher (shm_open() before ftruncate())
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    CHECK(fd>=0);
+    CHECK(!reader.openShared(name, false));
+    CHECK(!reader.read(0, reading));
+    close(fd);
+    CHECK(ADS1118Snapshot::removeShared(name));
+
+    return TEST_RESULT();
+}
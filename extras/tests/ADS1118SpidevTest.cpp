@@ -0,0 +1,131 @@
+/**
+*  Host tests of ADS1118Spidev through a mock spidev driver and a simulated ADS1118
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118Spidev.h"
+#include "MockSpidev.h"
+#include "SimulatedADS1118.h"
+#include "HostTest.h"
+
+#define FD 3
+
+/**
+ * Scanning the inputs given and checking that value i is the conversion of inputs[i]
+ * (frame i+1 carries the conversion started by frame i)
+ */
+static void checkScan(ADS1118Spidev &ads1118, SimulatedADS1118 &chip, MockSpidev &mock, const uint8_t *inputs, uint8_t count) {
+    uint16_t values[ADS1118Spidev::MAX_INPUTS];
+    bool valid[ADS1118Spidev::MAX_INPUTS];
+    uint32_t syscalls = ads1118.getSyscalls();
+    uint32_t messages = mock.getMessages();
+    uint32_t frames = chip.getFrames();
+    CHECK(ads1118.scan(inputs, count, values, valid));
+    CHECK(ads1118.getSyscalls() - syscalls == 1);
+    CHECK(mock.getMessages() - messages == 1);
+    CHECK(chip.getFrames() - frames == (uint32_t)count + 1);
+    CHECK(!mock.csSelected());
+    for (uint8_t i = 0; i < count; i++) {
+        CHECK(valid[i]);
+        CHECK(values[i] == chip.codeFor(inputs[i], ads1118.configRegister.bits.pga));
+    }
+}
+
+int main() {
+    SimulatedADS1118 chip;
+    MockSpidev mock(chip);
+    ADS1118Spidev ads1118("/dev/spidev0.0", MockSpidev::ioctl);
+    const uint8_t inputs[] = {ADS1118Spidev::AIN_0, ADS1118Spidev::AIN_1, ADS1118Spidev::AIN_2, ADS1118Spidev::AIN_3,
+                              ADS1118Spidev::DIFF_0_1, ADS1118Spidev::AIN_0, ADS1118Spidev::AIN_0, ADS1118Spidev::DIFF_2_3};
+    for (uint8_t mux = 0; mux < 8; mux++) chip.setInput(mux, 100.0f*mux - 350);
+
+    //begin(): mode 1, 8 bits, SCLK, three calls
+    CHECK(ads1118.begin(FD));
+    CHECK(ads1118.getSyscalls() == 3);
+    CHECK(mock.getIoctls() == 3);
+    CHECK(mock.getMode() == SPI_MODE_1);
+    CHECK(mock.getBitsPerWord() == 8);
+    CHECK(mock.getSpeed() == ADS1118Spidev::SCLK);
+
+    //860 SPS: one transfer per frame, cs_change in every transfer but the last one
+    ads1118.setSamplingRate(ADS1118Spidev::RATE_860SPS);
+    ads1118.setFullScaleRange(ADS1118Spidev::FSR_1024);
+    checkScan(ads1118, chip, mock, inputs, 4);
+    const std::vector<struct spi_ioc_transfer> &message = mock.lastMessage();
+    CHECK(message.size() == 5);
+    for (size_t i = 0; i < message.size(); i++) {
+        CHECK(message[i].len == 4);
+        CHECK(message[i].cs_change == (i + 1 < message.size() ? 1 : 0));
+        CHECK(message[i].delay_usecs == (i + 1 < message.size() ? 1280 : 0));
+    }
+    CHECK(mock.getMessageNs() >= 4*1280000ULL);
+
+    //Repeated inputs and the whole input list
+    checkScan(ads1118, chip, mock, inputs, 8);
+    checkScan(ads1118, chip, mock, inputs + 5, 2);
+
+    //8 SPS: 137500us waits are split in 65535 + 65535 + 6430 (delay_usecs is 16 bits)
+    ads1118.setSamplingRate(ADS1118Spidev::RATE_8SPS);
+    checkScan(ads1118, chip, mock, inputs, 1);
+    CHECK(message.size() == 4);
+    if (message.size() == 4) {
+        CHECK(message[0].len == 4 && message[0].delay_usecs == 65535 && message[0].cs_change == 0);
+        CHECK(message[1].len == 0 && message[1].delay_usecs == 65535 && message[1].cs_change == 0);
+        CHECK(message[2].len == 0 && message[2].delay_usecs == 6430 && message[2].cs_change == 1);
+        CHECK(message[3].len == 4 && message[3].delay_usecs == 0 && message[3].cs_change == 0);
+    }
+    CHECK(mock.getMessageNs() >= 137500000ULL);
+
+    //Largest scan: 16 inputs at 8 SPS fit in the transfers array and in one call
+    uint8_t many[ADS1118Spidev::MAX_INPUTS];
+    for (uint8_t i = 0; i < ADS1118Spidev::MAX_INPUTS; i++) many[i] = inputs[i % 8];
+    checkScan(ads1118, chip, mock, many, ADS1118Spidev::MAX_INPUTS);
+    CHECK(message.size() == ADS1118Spidev::MAX_INPUTS*3 + 1);
+    CHECK(message.back().cs_change == 0);
+
+    //Invalid scans make no call
+    uint16_t values[ADS1118Spidev::MAX_INPUTS + 1];
+    bool valid[ADS1118Spidev::MAX_INPUTS + 1];
+    uint32_t syscalls = ads1118.getSyscalls();
+    CHECK(!ads1118.scan(inputs, 0, values, valid));
+    CHECK(!ads1118.scan(many, ADS1118Spidev::MAX_INPUTS + 1, values, valid));
+    CHECK(ads1118.getSyscalls() == syscalls);
+
+    //Corrupted echo in the third frame: the scan is repeated once, two calls
+    ads1118.setSamplingRate(ADS1118Spidev::RATE_475SPS);
+    chip.corruptEchoes(1, 0x1000, 2);
+    syscalls = ads1118.getSyscalls();
+    uint32_t errors = ads1118.getFrameErrors();
+    CHECK(ads1118.scan(inputs, 4, values, valid));
+    CHECK(ads1118.getSyscalls() - syscalls == 2);
+    CHECK(ads1118.getFrameErrors() - errors == 1);
+    for (uint8_t i = 0; i < 4; i++) {
+        CHECK(valid[i]);
+        CHECK(values[i] == chip.codeFor(inputs[i], ads1118.configRegister.bits.pga));
+    }
+
+    //Config corrupted on DIN in the first frame: the chip converts another input, the echo shows it
+    chip.corruptWrites(1, 0x1000);
+    syscalls = ads1118.getSyscalls();
+    CHECK(ads1118.scan(inputs, 4, values, valid));
+    CHECK(ads1118.getSyscalls() - syscalls == 2);
+    CHECK(values[0] == chip.codeFor(inputs[0], ads1118.configRegister.bits.pga));
+
+    //Persistent corruption: maxRetries extra scans, then the values are reported as invalid
+    ads1118.setMaxRetries(1);
+    chip.corruptEchoes(1000);
+    syscalls = ads1118.getSyscalls();
+    CHECK(ads1118.scan(inputs, 4, values, valid));
+    CHECK(ads1118.getSyscalls() - syscalls == 2);
+    for (uint8_t i = 0; i < 4; i++) CHECK(!valid[i]);
+    chip.corruptEchoes(0);
+
+    //Scan before begin(): no device, no call
+    ADS1118Spidev closed("/dev/spidev0.0", MockSpidev::ioctl);
+    CHECK(!closed.scan(inputs, 1, values, valid));
+
+    return TEST_RESULT();
+}
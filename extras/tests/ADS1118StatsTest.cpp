@@ -0,0 +1,148 @@
+/**
+*  Host tests of ADS1118Stats: accuracy on long runs against a long double reference and window handling
+*
+*  @author Alvaro Salazar <alvaro@denkitronik.com>
+*  http://www.denkitronik.com
+*
+*/
+
+#include "ADS1118Stats.h"
+#include "HostTest.h"
+#include <math.h>
+
+static uint32_t randomState = 12345;   ///< State of the xorshift generator (repeatable runs)
+
+/**
+ * Pseudo random number (xorshift32)
+ */
+static uint32_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+/**
+ * Code around a mean with uniform noise of +-noise codes, clamped to 16 bits
+ */
+static uint16_t noisyCode(int32_t mean, int32_t noise) {
+    int32_t code = mean + (int32_t)(nextRandom() % (2*noise + 1)) - noise;
+    if (code > 32767) code = 32767;
+    if (code < -32768) code = -32768;
+    return (uint16_t)(int16_t)code;
+}
+
+///Reference statistics (Welford in long double)
+struct Reference {
+    uint32_t count;
+    long double mean, m2, sumSquares;
+    int16_t min, max;
+    void clear() { count = 0; mean = m2 = sumSquares = 0; min = 32767; max = -32768; }
+    void add(uint16_t code) {
+        int16_t value = (int16_t)code;
+        count++;
+        long double delta = value - mean;
+        mean += delta/count;
+        m2 += delta*(value - mean);
+        sumSquares += (long double)value*value;
+        if (value < min) min = value;
+        if (value > max) max = value;
+    }
+};
+
+/**
+ * Comparing a summary with the reference (relative tolerance on mean, variance and RMS)
+ */
+static void checkSummary(const ADS1118Summary &summary, const Reference &reference, double tolerance) {
+    CHECK(summary.count == reference.count);
+    CHECK(summary.min == reference.min);
+    CHECK(summary.max == reference.max);
+    double variance = (double)(reference.m2/reference.count);
+    double rms = (double)sqrtl(reference.sumSquares/reference.count);
+    CHECK_NEAR(summary.mean, (double)reference.mean, tolerance*fabs((double)reference.mean) + 1e-6);
+    CHECK_NEAR(summary.variance, variance, tolerance*variance + 1e-6);
+    CHECK_NEAR(summary.rms, rms, tolerance*rms + 1e-6);
+}
+
+/**
+ * Long run without window: the integer sums must stay exact
+ */
+static void longRun(int32_t mean, int32_t noise, uint16_t first, uint32_t samples, double tolerance) {
+    ADS1118Stats stats;
+    Reference reference;
+    reference.clear();
+    stats.add(first);
+    reference.add(first);
+    for (uint32_t i = 1; i < samples; i++) {
+        uint16_t code = noisyCode(mean, noise);
+        stats.add(code);
+        reference.add(code);
+    }
+    ADS1118Summary summary;
+    CHECK(stats.snapshot(summary));
+    checkSummary(summary, reference, tolerance);
+}
+
+int main() {
+    ADS1118Summary summary;
+
+    //Empty and constant inputs
+    ADS1118Stats empty;
+    CHECK(!empty.snapshot(summary));
+    CHECK(!empty.windowComplete());
+    ADS1118Stats constant;
+    for (int i = 0; i < 1000; i++) constant.add((uint16_t)-1234);
+    CHECK(constant.snapshot(summary));
+    CHECK(summary.min == -1234 && summary.max == -1234);
+    CHECK(summary.mean == -1234);
+    CHECK(summary.variance == 0);
+    CHECK_NEAR(summary.rms, 1234, 1e-3);
+
+    //Long runs: DC with little noise (mean >> deviation), full scale noise, negative codes
+    longRun(30000, 3, (uint16_t)30000, 10000000, 1e-6);
+    longRun(0, 32767, 0, 10000000, 1e-6);
+    longRun(-20000, 100, (uint16_t)-20000, 10000000, 1e-6);
+    //First sample far from the rest: the shift doesn't help, the sums are still exact
+    longRun(32000, 2, (uint16_t)-32768, 10000000, 1e-5);
+
+    //Tumbling windows: every window is independent
+    ADS1118Stats tumbling(1000, ADS1118Stats::TUMBLING);
+    Reference window;
+    window.clear();
+    for (uint32_t i = 0; i < 10000; i++) {
+        uint16_t code = noisyCode(i < 5000 ? 100 : -3000, 50);
+        tumbling.add(code);
+        window.add(code);
+        CHECK(tumbling.getCount() == window.count);
+        if (tumbling.windowComplete()) {
+            CHECK(window.count == 1000);
+            CHECK(tumbling.snapshot(summary));
+            checkSummary(summary, window, 1e-6);
+            window.clear();
+        }
+    }
+
+    //Sliding windows: the snapshot covers the previous and the current pane
+    ADS1118Stats sliding(500, ADS1118Stats::SLIDING);
+    uint16_t history[10000];
+    for (uint32_t i = 0; i < 10000; i++) {
+        history[i] = noisyCode(i < 3000 ? 32000 : -32000, 700);
+        sliding.add(history[i]);
+        uint32_t inPane = i % 500 + 1;
+        uint32_t covered = i < 500 ? i + 1 : 500 + inPane;
+        Reference reference;
+        reference.clear();
+        for (uint32_t j = i + 1 - covered; j <= i; j++) reference.add(history[j]);
+        CHECK(sliding.snapshot(summary));
+        checkSummary(summary, reference, 1e-6);
+    }
+
+    //reset() discards everything, including the shift
+    sliding.reset();
+    CHECK(!sliding.snapshot(summary));
+    sliding.add(7);
+    CHECK(sliding.snapshot(summary));
+    CHECK(summary.count == 1 && summary.mean == 7 && summary.variance == 0);
+
+    return TEST_RESULT();
+}
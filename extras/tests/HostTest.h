@@ -0,0 +1,30 @@
+#ifndef HostTest_h
+#define HostTest_h
+
+/**
+ * Checks used by the host tests: every failed check is printed and counted, and
+ * TEST_RESULT() is the exit status of the test (0 if every check passed).
+ */
+
+#include <stdio.h>
+
+static int testFailures = 0;   ///< Number of failed checks
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            testFailures++; \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(value, expected, tolerance) do { \
+        double checkValue = (value), checkExpected = (expected); \
+        if (checkValue - checkExpected > (tolerance) || checkExpected - checkValue > (tolerance)) { \
+            testFailures++; \
+            printf("%s:%d: %s = %.9g, expected %.9g\n", __FILE__, __LINE__, #value, checkValue, checkExpected); \
+        } \
+    } while (0)
+
+#define TEST_RESULT() (printf(testFailures ? "%d checks failed\n" : "All checks passed\n", testFailures), testFailures ? 1 : 0)
+
+#endif